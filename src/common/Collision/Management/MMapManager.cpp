@@ -20,12 +20,26 @@
 #include "Log.h"
 #include "Config.h"
 #include "MapDefines.h"
+#include <algorithm>
 
 namespace MMAP
 {
     static char const* const MAP_FILE_NAME_FORMAT = "%s/mmaps/%03i.mmap";
     static char const* const TILE_FILE_NAME_FORMAT = "%s/mmaps/%03i%02i%02i.mmtile";
 
+    // navmesh queries created by GetThreadNavMeshQuery(), freed on thread exit
+    struct ThreadNavMeshQueries
+    {
+        ~ThreadNavMeshQueries()
+        {
+            for (std::pair<uint32 const, dtNavMeshQuery*>& query : queries)
+                dtFreeNavMeshQuery(query.second);
+        }
+
+        NavMeshQuerySet queries;            // mapId to query
+    };
+    static thread_local ThreadNavMeshQueries threadNavMeshQueries;
+
     // ######################## MMapManager ########################
     MMapManager::~MMapManager()
     {
@@ -104,6 +118,7 @@ namespace MMAP
         // store inside our map list
         MMapData* mmap_data = new MMapData(mesh);
 
+        std::unique_lock<std::shared_mutex> lock(navMeshLock);
         itr->second = mmap_data;
         return true;
     }
@@ -181,10 +196,13 @@ namespace MMAP
         dtMeshHeader* header = (dtMeshHeader*)data;
         dtTileRef tileRef = 0;
 
+        std::unique_lock<std::shared_mutex> lock(navMeshLock);
+
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
         if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
         {
             mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+            mmap->pathCache.Clear();
             ++loadedTiles;
             TC_LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile %03i[%02i, %02i] into %03i[%02i, %02i]", mapId, x, y, mapId, header->x, header->y);
             return true;
@@ -221,6 +239,8 @@ namespace MMAP
 
         dtTileRef tileRef = mmap->loadedTileRefs[packedGridPos];
 
+        std::unique_lock<std::shared_mutex> lock(navMeshLock);
+
         // unload, and mark as non loaded
         if (dtStatusFailed(mmap->navMesh->removeTile(tileRef, nullptr, nullptr)))
         {
@@ -233,6 +253,7 @@ namespace MMAP
         else
         {
             mmap->loadedTileRefs.erase(packedGridPos);
+            mmap->pathCache.Clear();
             --loadedTiles;
             TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile %03i[%02i, %02i] from %03i", mapId, x, y, mapId);
             return true;
@@ -253,6 +274,8 @@ namespace MMAP
 
         // unload all tiles from given map
         MMapData* mmap = itr->second;
+        // held until the data is freed, pathfinding workers may be waiting to use it
+        std::unique_lock<std::shared_mutex> lock(navMeshLock);
         for (MMapTileSet::iterator i = mmap->loadedTileRefs.begin(); i != mmap->loadedTileRefs.end(); ++i)
         {
             uint32 x = (i->first >> 16);
@@ -334,4 +357,133 @@ namespace MMAP
 
         return mmap->navMeshQueries[instanceId];
     }
+
+    dtNavMeshQuery const* MMapManager::GetThreadNavMeshQuery(uint32 mapId)
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return nullptr;
+
+        dtNavMeshQuery*& query = threadNavMeshQueries.queries[mapId];
+        if (!query)
+        {
+            query = dtAllocNavMeshQuery();
+            ASSERT(query);
+        }
+
+        // mesh of this map might have been unloaded and created again since last use
+        if (query->getAttachedNavMesh() != itr->second->navMesh)
+        {
+            if (dtStatusFailed(query->init(itr->second->navMesh, 1024)))
+            {
+                dtFreeNavMeshQuery(query);
+                threadNavMeshQueries.queries.erase(mapId);
+                TC_LOG_ERROR("maps", "MMAP:GetThreadNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u", mapId);
+                return nullptr;
+            }
+        }
+
+        return query;
+    }
+
+    std::shared_lock<std::shared_mutex> MMapManager::LockNavMesh(uint32 mapId)
+    {
+        std::shared_lock<std::shared_mutex> lock(navMeshLock);
+        if (GetMMapData(mapId) == loadedMMaps.end())
+            return {};
+
+        return lock;
+    }
+
+    bool MMapManager::GetCachedPolyPath(uint32 mapId, PolyPathCacheKey const& key, dtPolyRef* path, uint32& pathSize, uint32 maxPathSize)
+    {
+        if (!pathCacheSize.load(std::memory_order_relaxed))
+            return false;
+
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return false;
+
+        if (!itr->second->pathCache.Find(key, path, pathSize, maxPathSize))
+        {
+            ++pathCacheMisses;
+            return false;
+        }
+
+        // tiles of another instance of this map might have changed since the corridor was found
+        for (uint32 i = 0; i < pathSize; ++i)
+        {
+            if (!itr->second->navMesh->isValidPolyRef(path[i]))
+            {
+                ++pathCacheMisses;
+                return false;
+            }
+        }
+
+        ++pathCacheHits;
+        return true;
+    }
+
+    void MMapManager::CachePolyPath(uint32 mapId, PolyPathCacheKey const& key, dtPolyRef const* path, uint32 pathSize)
+    {
+        uint32 const cacheSize = pathCacheSize.load(std::memory_order_relaxed);
+        if (!cacheSize)
+            return;
+
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return;
+
+        itr->second->pathCache.Insert(key, path, pathSize, cacheSize);
+    }
+
+    void MMapManager::ResetPathCacheStats(uint32& hits, uint32& misses)
+    {
+        hits = pathCacheHits.exchange(0);
+        misses = pathCacheMisses.exchange(0);
+    }
+
+    // ######################## PolyPathCache ########################
+    bool PolyPathCache::Find(PolyPathCacheKey const& key, dtPolyRef* path, uint32& pathSize, uint32 maxPathSize)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto itr = index.find(key);
+        if (itr == index.end() || itr->second->second.size() > maxPathSize)
+            return false;
+
+        entries.splice(entries.begin(), entries, itr->second);
+
+        std::vector<dtPolyRef> const& cached = itr->second->second;
+        std::copy(cached.begin(), cached.end(), path);
+        pathSize = uint32(cached.size());
+        return true;
+    }
+
+    void PolyPathCache::Insert(PolyPathCacheKey const& key, dtPolyRef const* path, uint32 pathSize, uint32 capacity)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto itr = index.find(key);
+        if (itr != index.end())
+        {
+            itr->second->second.assign(path, path + pathSize);
+            entries.splice(entries.begin(), entries, itr->second);
+            return;
+        }
+
+        while (!entries.empty() && entries.size() >= capacity)
+        {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+
+        entries.emplace_front(key, std::vector<dtPolyRef>(path, path + pathSize));
+        index[key] = entries.begin();
+    }
+
+    void PolyPathCache::Clear()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        entries.clear();
+        index.clear();
+    }
 }
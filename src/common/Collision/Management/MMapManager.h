@@ -21,6 +21,10 @@
 #include "Define.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -31,6 +35,46 @@ namespace MMAP
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
     typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
 
+    // polygon corridor request, filter flags are part of the key since they change which polygons can be crossed
+    struct PolyPathCacheKey
+    {
+        dtPolyRef startPoly;
+        dtPolyRef endPoly;
+        uint16 includeFlags;
+        uint16 excludeFlags;
+
+        bool operator==(PolyPathCacheKey const& right) const
+        {
+            return startPoly == right.startPoly && endPoly == right.endPoly && includeFlags == right.includeFlags && excludeFlags == right.excludeFlags;
+        }
+    };
+
+    struct PolyPathCacheKeyHash
+    {
+        size_t operator()(PolyPathCacheKey const& key) const
+        {
+            return std::hash<uint64>()((uint64(key.startPoly) << 32) ^ uint64(key.endPoly) ^ (uint64(key.includeFlags) << 16) ^ key.excludeFlags);
+        }
+    };
+
+    // least recently used polygon corridors found by dtNavMeshQuery::findPath()
+    // polygon refs die with their tiles, so the cache is cleared whenever tiles are added or removed
+    class TC_COMMON_API PolyPathCache
+    {
+        public:
+            bool Find(PolyPathCacheKey const& key, dtPolyRef* path, uint32& pathSize, uint32 maxPathSize);
+            void Insert(PolyPathCacheKey const& key, dtPolyRef const* path, uint32 pathSize, uint32 capacity);
+            void Clear();
+
+        private:
+            typedef std::pair<PolyPathCacheKey, std::vector<dtPolyRef>> PolyPathEntry;
+            typedef std::list<PolyPathEntry> PolyPathList;
+
+            PolyPathList entries;           // most recently used first
+            std::unordered_map<PolyPathCacheKey, PolyPathList::iterator, PolyPathCacheKeyHash> index;
+            std::mutex lock;                // used by map update and pathfinding worker threads
+    };
+
     // dummy struct to hold map's mmap data
     struct TC_COMMON_API MMapData
     {
@@ -49,6 +93,7 @@ namespace MMAP
 
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs;        // maps [map grid coords] to [dtTile]
+        PolyPathCache pathCache;
     };
 
     typedef std::unordered_map<uint32, MMapData*> MMapDataSet;
@@ -58,7 +103,7 @@ namespace MMAP
     class TC_COMMON_API MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0), thread_safe_environment(true) {}
+            MMapManager() : loadedTiles(0), thread_safe_environment(true), pathCacheSize(0), pathCacheHits(0), pathCacheMisses(0) {}
             ~MMapManager();
 
             void InitializeThreadUnsafe(const std::vector<uint32>& mapIds);
@@ -71,6 +116,21 @@ namespace MMAP
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
+            // query owned by the calling thread, for use outside of map update threads
+            // navmesh must be locked with LockNavMesh() while the query is used
+            dtNavMeshQuery const* GetThreadNavMeshQuery(uint32 mapId);
+            // returned lock does not own the mutex if the map has no navmesh loaded
+            // while it is held no tiles are added or removed and no map data is freed
+            std::shared_lock<std::shared_mutex> LockNavMesh(uint32 mapId);
+
+            // corridors are cached per map, size 0 disables the cache
+            // may be changed by config reload while path workers use the cache
+            void SetPathCacheSize(uint32 size) { pathCacheSize.store(size, std::memory_order_relaxed); }
+            bool GetCachedPolyPath(uint32 mapId, PolyPathCacheKey const& key, dtPolyRef* path, uint32& pathSize, uint32 maxPathSize);
+            void CachePolyPath(uint32 mapId, PolyPathCacheKey const& key, dtPolyRef const* path, uint32 pathSize);
+            // hits and misses since last call
+            void ResetPathCacheStats(uint32& hits, uint32& misses);
+
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return uint32(loadedMMaps.size()); }
         private:
@@ -81,6 +141,10 @@ namespace MMAP
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
             bool thread_safe_environment;
+            std::atomic<uint32> pathCacheSize;
+            std::atomic<uint32> pathCacheHits;
+            std::atomic<uint32> pathCacheMisses;
+            std::shared_mutex navMeshLock;      // held exclusively while map data or tiles are added or removed
     };
 }
 
@@ -0,0 +1,135 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPSCQueue_h__
+#define SPSCQueue_h__
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/*
+ * Unbounded lock free queue for exactly one producer thread and one consumer thread.
+ * Items are stored in linked blocks of BlockSize slots, the block last emptied by the consumer
+ * is handed back to the producer so a queue that does not keep growing stops allocating.
+ */
+template<typename T, std::size_t BlockSize = 128>
+class SPSCQueue
+{
+    static_assert(BlockSize > 0, "BlockSize must not be 0");
+
+public:
+    SPSCQueue() : _tail(new Block()), _tailIndex(0), _head(_tail), _headIndex(0), _spare(nullptr) { }
+
+    ~SPSCQueue()
+    {
+        while (_head)
+        {
+            Block* next = _head->Next.load(std::memory_order_relaxed);
+            delete _head;
+            _head = next;
+        }
+
+        delete _spare.load(std::memory_order_relaxed);
+    }
+
+    //! Producer only
+    void Enqueue(T const& input)
+    {
+        if (_tailIndex == BlockSize)
+        {
+            Block* block = _spare.exchange(nullptr, std::memory_order_acquire);
+            if (block)
+            {
+                block->Written.store(0, std::memory_order_relaxed);
+                block->Next.store(nullptr, std::memory_order_relaxed);
+            }
+            else
+                block = new Block();
+
+            _tail->Next.store(block, std::memory_order_release);
+            _tail = block;
+            _tailIndex = 0;
+        }
+
+        _tail->Items[_tailIndex] = input;
+        _tail->Written.store(++_tailIndex, std::memory_order_release);
+    }
+
+    //! Consumer only, returns the oldest item without removing it or nullptr if the queue is empty
+    T* Peek()
+    {
+        if (_headIndex == BlockSize)
+        {
+            Block* next = _head->Next.load(std::memory_order_acquire);
+            if (!next)
+                return nullptr;
+
+            Block* emptied = _head;
+            _head = next;
+            _headIndex = 0;
+            delete _spare.exchange(emptied, std::memory_order_acq_rel);
+        }
+
+        if (_headIndex == _head->Written.load(std::memory_order_acquire))
+            return nullptr;
+
+        return &_head->Items[_headIndex];
+    }
+
+    //! Consumer only, removes the item returned by last Peek()
+    void Pop()
+    {
+        ++_headIndex;
+    }
+
+    //! Consumer only
+    bool Dequeue(T& result)
+    {
+        T* front = Peek();
+        if (!front)
+            return false;
+
+        result = *front;
+        Pop();
+        return true;
+    }
+
+private:
+    struct Block
+    {
+        Block() : Written(0), Next(nullptr) { }
+
+        std::array<T, BlockSize> Items;
+        std::atomic<std::size_t> Written;
+        std::atomic<Block*> Next;
+    };
+
+    // producer and consumer state on separate cache lines
+    alignas(64) Block* _tail;
+    std::size_t _tailIndex;
+
+    alignas(64) Block* _head;
+    std::size_t _headIndex;
+
+    alignas(64) std::atomic<Block*> _spare;
+
+    SPSCQueue(SPSCQueue const&) = delete;
+    SPSCQueue& operator=(SPSCQueue const&) = delete;
+};
+
+#endif // SPSCQueue_h__
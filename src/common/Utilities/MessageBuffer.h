@@ -19,12 +19,12 @@
 #define __MESSAGEBUFFER_H_
 
 #include "Define.h"
-#include <vector>
+#include "PacketBufferPool.h"
 #include <cstring>
 
 class MessageBuffer
 {
-    typedef std::vector<uint8>::size_type size_type;
+    typedef PacketBufferStorage::size_type size_type;
 
 public:
     MessageBuffer() : _wpos(0), _rpos(0), _storage()
@@ -43,6 +43,9 @@ public:
 
     MessageBuffer(MessageBuffer&& right) : _wpos(right._wpos), _rpos(right._rpos), _storage(right.Move()) { }
 
+    // Takes over already filled storage without copying
+    explicit MessageBuffer(PacketBufferStorage&& storage) : _wpos(storage.size()), _rpos(0), _storage(std::move(storage)) { }
+
     void Reset()
     {
         _wpos = 0;
@@ -99,7 +102,7 @@ public:
         }
     }
 
-    std::vector<uint8>&& Move()
+    PacketBufferStorage&& Move()
     {
         _wpos = 0;
         _rpos = 0;
@@ -133,7 +136,7 @@ public:
 private:
     size_type _wpos;
     size_type _rpos;
-    std::vector<uint8> _storage;
+    PacketBufferStorage _storage;
 };
 
 #endif /* __MESSAGEBUFFER_H_ */
@@ -0,0 +1,149 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NodePool_h__
+#define NodePool_h__
+
+#include "Define.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+/*
+ * Per thread freelists of fixed size blocks, for node based containers (std::list, std::multimap) that are filled and emptied at a high rate.
+ * Nodes keep their addresses, so iterators of the containers stay as stable as with the default allocator.
+ * A block freed on another thread than the one that allocated it joins the freelist of the freeing thread,
+ * every freelist keeps at most MAX_CACHED_BLOCKS blocks and returns the rest to the system.
+ */
+template<std::size_t Size>
+class NodePool
+{
+public:
+    static constexpr std::size_t BLOCK_SIZE = std::max(Size, sizeof(void*));
+    static constexpr std::size_t MAX_CACHED_BLOCKS = 4096;
+
+    static void* Allocate()
+    {
+        FreeList& list = GetFreeList();
+        if (!list.Head)
+        {
+            if (!list.Released)
+                RegisterReleaser();
+            return ::operator new(BLOCK_SIZE);
+        }
+
+        FreeBlock* block = list.Head;
+        list.Head = block->Next;
+        --list.Count;
+        return block;
+    }
+
+    static void Deallocate(void* ptr) noexcept
+    {
+        FreeList& list = GetFreeList();
+        if (list.Released || list.Count >= MAX_CACHED_BLOCKS)
+        {
+            ::operator delete(ptr);
+            return;
+        }
+
+        RegisterReleaser();
+        list.Head = new (ptr) FreeBlock{ list.Head };
+        ++list.Count;
+    }
+
+    static std::size_t GetCachedBlocks() { return GetFreeList().Count; }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* Next;
+    };
+
+    // trivially destructible, stays usable for containers destroyed after the thread released its blocks
+    struct FreeList
+    {
+        FreeBlock* Head;
+        std::size_t Count;
+        bool Released;
+    };
+
+    struct FreeListReleaser
+    {
+        ~FreeListReleaser()
+        {
+            FreeList& list = GetFreeList();
+            while (FreeBlock* block = list.Head)
+            {
+                list.Head = block->Next;
+                ::operator delete(block);
+            }
+
+            list.Count = 0;
+            list.Released = true;
+        }
+    };
+
+    static FreeList& GetFreeList() noexcept
+    {
+        static thread_local FreeList list = { nullptr, 0, false };
+        return list;
+    }
+
+    static void RegisterReleaser()
+    {
+        static thread_local FreeListReleaser releaser;
+        (void)releaser;
+    }
+};
+
+//! Allocator serving single element allocations (container nodes) from NodePool, anything else from the system
+template<typename T>
+struct NodePoolAllocator
+{
+    typedef T value_type;
+
+    NodePoolAllocator() noexcept = default;
+    template<typename U>
+    NodePoolAllocator(NodePoolAllocator<U> const&) noexcept { }
+
+    T* allocate(std::size_t n)
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned nodes are not supported");
+
+        if (n != 1)
+            return std::allocator<T>().allocate(n);
+
+        return static_cast<T*>(NodePool<sizeof(T)>::Allocate());
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        if (n != 1)
+            std::allocator<T>().deallocate(ptr, n);
+        else
+            NodePool<sizeof(T)>::Deallocate(ptr);
+    }
+
+    template<typename U>
+    bool operator==(NodePoolAllocator<U> const&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(NodePoolAllocator<U> const&) const noexcept { return false; }
+};
+
+#endif // NodePool_h__
@@ -0,0 +1,279 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PacketBufferPool.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+
+namespace
+{
+    constexpr std::size_t MIN_SIZE_CLASS_SHIFT          = 6;                // 64 bytes
+    constexpr std::size_t MAX_SIZE_CLASS_SHIFT          = 16;               // 64 kB
+    constexpr std::size_t SIZE_CLASS_COUNT              = MAX_SIZE_CLASS_SHIFT - MIN_SIZE_CLASS_SHIFT + 1;
+    constexpr std::size_t THREAD_CACHE_BYTES_PER_CLASS  = 256 * 1024;
+    constexpr std::size_t SHARED_BYTES_PER_CLASS        = 4 * 1024 * 1024;
+    constexpr uint32 STATS_FLUSH_INTERVAL               = 1024;
+
+    std::size_t GetSizeClass(std::size_t size)
+    {
+        std::size_t sizeClass = 0;
+        while ((std::size_t(1) << (sizeClass + MIN_SIZE_CLASS_SHIFT)) < size)
+            ++sizeClass;
+        return sizeClass;
+    }
+
+    std::size_t GetClassSize(std::size_t sizeClass)
+    {
+        return std::size_t(1) << (sizeClass + MIN_SIZE_CLASS_SHIFT);
+    }
+
+    std::size_t GetThreadCacheLimit(std::size_t sizeClass)
+    {
+        return std::max<std::size_t>(THREAD_CACHE_BYTES_PER_CLASS / GetClassSize(sizeClass), 4);
+    }
+
+    struct FreeList
+    {
+        struct Block
+        {
+            Block* Next;
+        };
+
+        void Push(void* ptr)
+        {
+            Block* block = static_cast<Block*>(ptr);
+            block->Next = Head;
+            Head = block;
+            ++Count;
+        }
+
+        void* Pop()
+        {
+            Block* block = Head;
+            Head = block->Next;
+            --Count;
+            return block;
+        }
+
+        Block* Head = nullptr;
+        std::size_t Count = 0;
+    };
+
+    struct SharedPool
+    {
+        std::array<FreeList, SIZE_CLASS_COUNT> Lists;
+        std::array<std::mutex, SIZE_CLASS_COUNT> Locks;
+        std::atomic<uint64> Hits{ 0 };
+        std::atomic<uint64> Misses{ 0 };
+        std::atomic<uint64> Bytes{ 0 };
+        std::atomic<uint64> PeakBytes{ 0 };
+    };
+
+    // never destroyed, buffers owned by static objects can still be freed during static destruction
+    SharedPool& GetSharedPool()
+    {
+        static SharedPool* pool = new SharedPool();
+        return *pool;
+    }
+
+    void* AllocateFromSystem(std::size_t size)
+    {
+        SharedPool& shared = GetSharedPool();
+        uint64 bytes = shared.Bytes.fetch_add(size, std::memory_order_relaxed) + size;
+        uint64 peak = shared.PeakBytes.load(std::memory_order_relaxed);
+        while (peak < bytes && !shared.PeakBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed))
+            ;
+
+        return ::operator new(size);
+    }
+
+    void FreeToSystem(void* ptr, std::size_t size)
+    {
+        GetSharedPool().Bytes.fetch_sub(size, std::memory_order_relaxed);
+        ::operator delete(ptr);
+    }
+
+    // moves count blocks from list to the shared list of their class, anything above its limit is freed
+    void ReleaseToShared(std::size_t sizeClass, FreeList& list, std::size_t count)
+    {
+        SharedPool& shared = GetSharedPool();
+        std::size_t const maxShared = SHARED_BYTES_PER_CLASS / GetClassSize(sizeClass);
+        FreeList overflow;
+        {
+            std::lock_guard<std::mutex> lock(shared.Locks[sizeClass]);
+            FreeList& sharedList = shared.Lists[sizeClass];
+            while (count--)
+            {
+                if (sharedList.Count < maxShared)
+                    sharedList.Push(list.Pop());
+                else
+                    overflow.Push(list.Pop());
+            }
+        }
+
+        while (overflow.Count)
+            FreeToSystem(overflow.Pop(), GetClassSize(sizeClass));
+    }
+
+    // moves up to count blocks from the shared list of the class to list
+    void AcquireFromShared(std::size_t sizeClass, FreeList& list, std::size_t count)
+    {
+        SharedPool& shared = GetSharedPool();
+        std::lock_guard<std::mutex> lock(shared.Locks[sizeClass]);
+        FreeList& sharedList = shared.Lists[sizeClass];
+        count = std::min(count, sharedList.Count);
+        while (count--)
+            list.Push(sharedList.Pop());
+    }
+
+    class ThreadCache
+    {
+    public:
+        ThreadCache() : _hits(0), _misses(0) { }
+        ~ThreadCache();
+
+        void* Allocate(std::size_t sizeClass)
+        {
+            FreeList& list = _lists[sizeClass];
+            if (!list.Count)
+                AcquireFromShared(sizeClass, list, GetThreadCacheLimit(sizeClass) / 2);
+
+            void* ptr;
+            if (list.Count)
+            {
+                ++_hits;
+                ptr = list.Pop();
+            }
+            else
+            {
+                ++_misses;
+                ptr = AllocateFromSystem(GetClassSize(sizeClass));
+            }
+
+            if (_hits + _misses >= STATS_FLUSH_INTERVAL)
+                FlushStats();
+
+            return ptr;
+        }
+
+        void Deallocate(void* ptr, std::size_t sizeClass)
+        {
+            FreeList& list = _lists[sizeClass];
+            list.Push(ptr);
+            if (list.Count > GetThreadCacheLimit(sizeClass))
+                ReleaseToShared(sizeClass, list, list.Count / 2);
+        }
+
+    private:
+        void FlushStats()
+        {
+            SharedPool& shared = GetSharedPool();
+            shared.Hits.fetch_add(_hits, std::memory_order_relaxed);
+            shared.Misses.fetch_add(_misses, std::memory_order_relaxed);
+            _hits = 0;
+            _misses = 0;
+        }
+
+        std::array<FreeList, SIZE_CLASS_COUNT> _lists;
+        uint32 _hits;
+        uint32 _misses;
+    };
+
+    // set once the thread cache is gone, buffers freed by later thread_local destructors use the shared lists directly
+    thread_local bool ThreadCacheDestroyed = false;
+
+    ThreadCache::~ThreadCache()
+    {
+        for (std::size_t sizeClass = 0; sizeClass < SIZE_CLASS_COUNT; ++sizeClass)
+            ReleaseToShared(sizeClass, _lists[sizeClass], _lists[sizeClass].Count);
+
+        FlushStats();
+        ThreadCacheDestroyed = true;
+    }
+
+    ThreadCache* GetThreadCache()
+    {
+        if (ThreadCacheDestroyed)
+            return nullptr;
+
+        thread_local ThreadCache cache;
+        return &cache;
+    }
+}
+
+void* PacketBufferPool::Allocate(std::size_t size)
+{
+    size = std::max<std::size_t>(size, 1);
+    if (size > GetClassSize(SIZE_CLASS_COUNT - 1))
+    {
+        GetSharedPool().Misses.fetch_add(1, std::memory_order_relaxed);
+        return AllocateFromSystem(size);
+    }
+
+    std::size_t sizeClass = GetSizeClass(size);
+    if (ThreadCache* cache = GetThreadCache())
+        return cache->Allocate(sizeClass);
+
+    FreeList list;
+    AcquireFromShared(sizeClass, list, 1);
+    if (list.Count)
+    {
+        GetSharedPool().Hits.fetch_add(1, std::memory_order_relaxed);
+        return list.Pop();
+    }
+
+    GetSharedPool().Misses.fetch_add(1, std::memory_order_relaxed);
+    return AllocateFromSystem(GetClassSize(sizeClass));
+}
+
+void PacketBufferPool::Deallocate(void* ptr, std::size_t size)
+{
+    if (!ptr)
+        return;
+
+    size = std::max<std::size_t>(size, 1);
+    if (size > GetClassSize(SIZE_CLASS_COUNT - 1))
+    {
+        FreeToSystem(ptr, size);
+        return;
+    }
+
+    std::size_t sizeClass = GetSizeClass(size);
+    if (ThreadCache* cache = GetThreadCache())
+    {
+        cache->Deallocate(ptr, sizeClass);
+        return;
+    }
+
+    FreeList list;
+    list.Push(ptr);
+    ReleaseToShared(sizeClass, list, 1);
+}
+
+PacketBufferPool::Stats PacketBufferPool::ResetStats()
+{
+    SharedPool& shared = GetSharedPool();
+    Stats stats;
+    stats.Hits = shared.Hits.exchange(0, std::memory_order_relaxed);
+    stats.Misses = shared.Misses.exchange(0, std::memory_order_relaxed);
+    stats.Bytes = shared.Bytes.load(std::memory_order_relaxed);
+    stats.PeakBytes = shared.PeakBytes.exchange(stats.Bytes, std::memory_order_relaxed);
+    return stats;
+}
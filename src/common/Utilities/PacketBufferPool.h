@@ -0,0 +1,68 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PacketBufferPool_h__
+#define PacketBufferPool_h__
+
+#include "Define.h"
+#include <cstddef>
+#include <vector>
+
+/*
+ * Size class pool backing packet storage (ByteBuffer and MessageBuffer).
+ * Every thread keeps its own freelists, blocks freed on another thread than the one that allocated them
+ * (packets built by map threads are freed by network threads once sent) flow back through shared per class lists.
+ * Allocations larger than the biggest size class go straight to the system allocator.
+ */
+class TC_COMMON_API PacketBufferPool
+{
+public:
+    // hits and misses are totals over all threads since last ResetStats(), flushed in batches by each thread
+    struct Stats
+    {
+        uint64 Hits = 0;
+        uint64 Misses = 0;
+        uint64 Bytes = 0;       // currently allocated from the system, in use or pooled
+        uint64 PeakBytes = 0;   // highest Bytes since last ResetStats()
+    };
+
+    static void* Allocate(std::size_t size);
+    static void Deallocate(void* ptr, std::size_t size);
+    static Stats ResetStats();
+};
+
+template<typename T>
+struct PacketBufferAllocator
+{
+    typedef T value_type;
+
+    PacketBufferAllocator() noexcept = default;
+    template<typename U>
+    PacketBufferAllocator(PacketBufferAllocator<U> const&) noexcept { }
+
+    T* allocate(std::size_t n) { return static_cast<T*>(PacketBufferPool::Allocate(n * sizeof(T))); }
+    void deallocate(T* ptr, std::size_t n) noexcept { PacketBufferPool::Deallocate(ptr, n * sizeof(T)); }
+
+    template<typename U>
+    bool operator==(PacketBufferAllocator<U> const&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(PacketBufferAllocator<U> const&) const noexcept { return false; }
+};
+
+typedef std::vector<uint8, PacketBufferAllocator<uint8>> PacketBufferStorage;
+
+#endif // PacketBufferPool_h__
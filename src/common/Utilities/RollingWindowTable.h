@@ -0,0 +1,146 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_ROLLINGWINDOWTABLE_H
+#define TRINITY_ROLLINGWINDOWTABLE_H
+
+#include "Define.h"
+#include <array>
+
+/**
+ * Fixed capacity table of per key sums over a rolling window of Periods periods.
+ * Keys are stored in an open addressed table of ring buffers sharing one period cursor,
+ * so no memory is allocated after construction and sums are kept up to date on every Add().
+ * Key 0 is reserved for empty slots.
+ */
+template<uint32 Capacity, uint32 Periods>
+class RollingWindowTable
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(Periods > 0, "At least one period is required");
+
+public:
+    RollingWindowTable() { Clear(); }
+
+    // Adds value to current period of key, returns false if key is new and table is full
+    bool Add(uint64 key, uint32 value)
+    {
+        if (!key)
+            return false;
+
+        Slot* slot = Find(key);
+        if (!slot)
+        {
+            if (_size * 4 >= Capacity * 3)
+            {
+                Compact();
+                // keep at least one empty slot so probing always terminates
+                if (_size + 1 >= Capacity)
+                    return false;
+            }
+
+            slot = &_slots[Probe(key)];
+            slot->Key = key;
+            ++_size;
+        }
+
+        slot->Values[_cursor] += value;
+        slot->Total += value;
+        return true;
+    }
+
+    // Sum of values of key over the whole window
+    uint32 GetTotal(uint64 key) const
+    {
+        Slot const* slot = Find(key);
+        return slot ? slot->Total : 0;
+    }
+
+    // Starts a new period, dropping the oldest one
+    void Advance()
+    {
+        _cursor = (_cursor + 1) % Periods;
+        for (Slot& slot : _slots)
+        {
+            if (slot.Key)
+            {
+                slot.Total -= slot.Values[_cursor];
+                slot.Values[_cursor] = 0;
+            }
+        }
+    }
+
+    void Clear()
+    {
+        _slots.fill(Slot());
+        _cursor = 0;
+        _size = 0;
+    }
+
+    uint32 GetSize() const { return _size; }
+    static constexpr uint32 GetCapacity() { return Capacity; }
+
+private:
+    struct Slot
+    {
+        uint64 Key = 0;
+        uint32 Total = 0;
+        std::array<uint32, Periods> Values = { };
+    };
+
+    static uint32 Hash(uint64 key) { return uint32((key ^ (key >> 32)) * 2654435761u); }
+
+    // Index of key or of first empty slot in its probe sequence
+    uint32 Probe(uint64 key) const
+    {
+        uint32 index = Hash(key) & (Capacity - 1);
+        while (_slots[index].Key && _slots[index].Key != key)
+            index = (index + 1) & (Capacity - 1);
+        return index;
+    }
+
+    Slot* Find(uint64 key) { return const_cast<Slot*>(static_cast<RollingWindowTable const*>(this)->Find(key)); }
+    Slot const* Find(uint64 key) const
+    {
+        if (!key || !_size)
+            return nullptr;
+        Slot const& slot = _slots[Probe(key)];
+        return slot.Key ? &slot : nullptr;
+    }
+
+    // Drops keys with nothing left in the window, rehashing the rest
+    void Compact()
+    {
+        std::array<Slot, Capacity> old = _slots;
+        _slots.fill(Slot());
+        _size = 0;
+        for (Slot const& slot : old)
+        {
+            if (slot.Key && slot.Total)
+            {
+                _slots[Probe(slot.Key)] = slot;
+                ++_size;
+            }
+        }
+    }
+
+    std::array<Slot, Capacity> _slots;
+    uint32 _cursor;
+    uint32 _size;
+};
+
+#endif // TRINITY_ROLLINGWINDOWTABLE_H
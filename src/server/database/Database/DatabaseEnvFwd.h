@@ -84,6 +84,15 @@ using WorldDatabaseQueryHolder = SQLQueryHolder<WorldDatabaseConnection>;
 
 class SQLQueryHolderCallback;
 
+//! Priority classes of async operations, each served from its own lane of the worker pool queue
+enum SQLOperationPriority
+{
+    SQL_PRIORITY_INTERACTIVE,   // results someone is waiting on, e.g. login query holders
+    SQL_PRIORITY_SAVE,          // player and world state saves
+    SQL_PRIORITY_BACKGROUND,    // logs, cleanups and other writes nobody waits on
+    MAX_SQL_PRIORITY
+};
+
 // mysql
 struct MySQLHandle;
 struct MySQLResult;
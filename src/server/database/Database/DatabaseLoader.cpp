@@ -54,6 +54,8 @@ DatabaseLoader& DatabaseLoader::AddDatabase(DatabaseWorkerPool<T>& pool, std::st
         uint8 const synchThreads = uint8(sConfigMgr->GetIntDefault(name + "Database.SynchThreads", 1));
 
         pool.SetConnectionInfo(dbString, asyncThreads, synchThreads);
+        pool.SetQueryCacheLimits(sConfigMgr->GetIntDefault(name + "Database.QueryCacheSize", 1024),
+            sConfigMgr->GetIntDefault(name + "Database.QueryCacheMaxRows", 256));
         if (uint32 error = pool.Open())
         {
             // Database does not exist
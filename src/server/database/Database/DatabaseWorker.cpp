@@ -17,12 +17,13 @@
 
 #include "DatabaseWorker.h"
 #include "SQLOperation.h"
-#include "ProducerConsumerQueue.h"
+#include "SQLOperationQueue.h"
 
-DatabaseWorker::DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection)
+DatabaseWorker::DatabaseWorker(SQLOperationQueue* newQueue, MySQLConnection* connection)
 {
     _connection = connection;
     _queue = newQueue;
+    _queueWorker = _queue->RegisterWorker();
     _cancelationToken = false;
     _workerThread = std::thread(&DatabaseWorker::WorkerThread, this);
 }
@@ -43,16 +44,16 @@ void DatabaseWorker::WorkerThread()
 
     for (;;)
     {
-        SQLOperation* operation = nullptr;
-
-        _queue->WaitAndPop(operation);
-
-        if (_cancelationToken || !operation)
+        SQLOperationQueue::Entry entry;
+        if (!_queue->WaitAndPop(_queueWorker, entry) || _cancelationToken)
             return;
 
+        SQLOperation* operation = entry.Operation;
         operation->SetConnection(_connection);
         operation->call();
 
         delete operation;
+
+        _queue->Complete(entry);
     }
 }
@@ -22,21 +22,20 @@
 #include <atomic>
 #include <thread>
 
-template <typename T>
-class ProducerConsumerQueue;
-
 class MySQLConnection;
 class SQLOperation;
+class SQLOperationQueue;
 
 class TC_DATABASE_API DatabaseWorker
 {
     public:
-        DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection);
+        DatabaseWorker(SQLOperationQueue* newQueue, MySQLConnection* connection);
         ~DatabaseWorker();
 
     private:
-        ProducerConsumerQueue<SQLOperation*>* _queue;
+        SQLOperationQueue* _queue;
         MySQLConnection* _connection;
+        uint32 _queueWorker;
 
         void WorkerThread();
         std::thread _workerThread;
@@ -25,11 +25,12 @@
 #include "Log.h"
 #include "MySQLPreparedStatement.h"
 #include "PreparedStatement.h"
-#include "ProducerConsumerQueue.h"
 #include "QueryCallback.h"
 #include "QueryHolder.h"
+#include "QueryResultCache.h"
 #include "QueryResult.h"
 #include "SQLOperation.h"
+#include "SQLOperationQueue.h"
 #include "Transaction.h"
 #include "MySQLWorkaround.h"
 #include <mysqld_error.h>
@@ -60,7 +61,7 @@ class PingOperation : public SQLOperation
 
 template <class T>
 DatabaseWorkerPool<T>::DatabaseWorkerPool()
-    : _queue(new ProducerConsumerQueue<SQLOperation*>()),
+    : _queue(new SQLOperationQueue()), _queryCache(new QueryResultCache()),
       _async_threads(0), _synch_threads(0)
 {
     WPFatal(mysql_thread_safe(), "Used MySQL library isn't thread-safe.");
@@ -99,6 +100,10 @@ uint32 DatabaseWorkerPool<T>::Open()
         "Asynchronous connections: %u, synchronous connections: %u.",
         GetDatabaseName(), _async_threads, _synch_threads);
 
+    //! With more than one async connection keep one worker for interactive loads only,
+    //! so a burst of saves can never occupy every connection while a player waits on a query holder.
+    _queue->SetReservedWorkers(_async_threads > 1 ? 1 : 0);
+
     uint32 error = OpenConnections(IDX_ASYNC, _async_threads);
 
     if (error)
@@ -217,33 +222,66 @@ PreparedQueryResult DatabaseWorkerPool<T>::Query(PreparedStatement<T>* stmt)
     return PreparedQueryResult(ret);
 }
 
+template <class T>
+PreparedQueryResult DatabaseWorkerPool<T>::CachedQuery(PreparedStatement<T>* stmt)
+{
+    PreparedQueryResult result;
+    if (_queryCache->Get(stmt, result))
+    {
+        delete stmt;
+        return result;
+    }
+
+    if (!_queryCache->IsEnabled())
+        return Query(stmt);
+
+    //! Query() deletes the statement, the key has to be stored first
+    T* connection = GetFreeConnection();
+    PreparedResultSet* ret = connection->Query(stmt);
+    connection->Unlock();
+
+    //! Failed queries are not cached, only results actually returned by the server
+    if (ret)
+    {
+        if (ret->GetRowCount())
+            result = PreparedQueryResult(ret);
+        else
+            delete ret;
+
+        _queryCache->Store(stmt, result);
+    }
+
+    delete stmt;
+    return result;
+}
+
 template <class T>
 QueryCallback DatabaseWorkerPool<T>::AsyncQuery(char const* sql)
 {
     BasicStatementTask* task = new BasicStatementTask(sql, true);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     QueryResultFuture result = task->GetFuture();
-    Enqueue(task);
+    Enqueue(task, SQL_PRIORITY_INTERACTIVE);
     return QueryCallback(std::move(result));
 }
 
 template <class T>
-QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement<T>* stmt)
+QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement<T>* stmt, uint32 orderKey /*= 0*/)
 {
     PreparedStatementTask* task = new PreparedStatementTask(stmt, true);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     PreparedQueryResultFuture result = task->GetFuture();
-    Enqueue(task);
+    Enqueue(task, SQL_PRIORITY_INTERACTIVE, orderKey);
     return QueryCallback(std::move(result));
 }
 
 template <class T>
-SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder)
+SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder, uint32 orderKey /*= 0*/)
 {
     SQLQueryHolderTask* task = new SQLQueryHolderTask(holder);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     QueryResultHolderFuture result = task->GetFuture();
-    Enqueue(task);
+    Enqueue(task, SQL_PRIORITY_INTERACTIVE, orderKey);
     return { std::move(holder), std::move(result) };
 }
 
@@ -254,7 +292,7 @@ SQLTransaction<T> DatabaseWorkerPool<T>::BeginTransaction()
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
+void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction, SQLOperationPriority priority /*= SQL_PRIORITY_SAVE*/, uint32 orderKey /*= 0*/)
 {
 #ifdef TRINITY_DEBUG
     //! Only analyze transaction weaknesses in Debug mode.
@@ -273,7 +311,7 @@ void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
     }
 #endif // TRINITY_DEBUG
 
-    Enqueue(new TransactionTask(transaction));
+    Enqueue(new TransactionTask(transaction), priority, orderKey);
 }
 
 template <class T>
@@ -298,7 +336,7 @@ TransactionCallback DatabaseWorkerPool<T>::AsyncCommitTransaction(SQLTransaction
 
     TransactionWithResultTask* task = new TransactionWithResultTask(transaction);
     TransactionFuture result = task->GetFuture();
-    Enqueue(task);
+    Enqueue(task, SQL_PRIORITY_INTERACTIVE);
     return TransactionCallback(std::move(result));
 }
 
@@ -366,9 +404,10 @@ void DatabaseWorkerPool<T>::KeepAlive()
     //! Assuming all worker threads are free, every worker thread will receive 1 ping operation request
     //! If one or more worker threads are busy, the ping operations will not be split evenly, but this doesn't matter
     //! as the sole purpose is to prevent connections from idling.
+    //! Interactive lane is the only one served by reserved workers, so their connections are kept alive as well.
     auto const count = _connections[IDX_ASYNC].size();
     for (uint8 i = 0; i < count; ++i)
-        Enqueue(new PingOperation);
+        Enqueue(new PingOperation, SQL_PRIORITY_INTERACTIVE);
 }
 
 template <class T>
@@ -429,9 +468,33 @@ unsigned long DatabaseWorkerPool<T>::EscapeString(char* to, char const* from, un
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op)
+void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op, SQLOperationPriority priority, uint32 orderKey /*= 0*/)
 {
-    _queue->Push(op);
+    _queue->Push(op, priority, orderKey);
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::SetQueryCacheLimits(uint32 maxEntries, uint32 maxRowsPerResult)
+{
+    _queryCache->SetLimits(maxEntries, maxRowsPerResult);
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::InvalidateQueryCache()
+{
+    _queryCache->Invalidate();
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::InvalidateQueryCache(PreparedStatementIndex index)
+{
+    _queryCache->Invalidate(index);
+}
+
+template <class T>
+uint32 DatabaseWorkerPool<T>::GetQueryCacheSize() const
+{
+    return _queryCache->GetSize();
 }
 
 template <class T>
@@ -440,6 +503,18 @@ size_t DatabaseWorkerPool<T>::QueueSize() const
     return _queue->Size();
 }
 
+template <class T>
+size_t DatabaseWorkerPool<T>::QueueSize(SQLOperationPriority priority) const
+{
+    return _queue->Size(priority);
+}
+
+template <class T>
+SQLOperationQueueStats DatabaseWorkerPool<T>::ResetQueueStats()
+{
+    return _queue->ResetStats();
+}
+
 template <class T>
 T* DatabaseWorkerPool<T>::GetFreeConnection()
 {
@@ -474,20 +549,20 @@ char const* DatabaseWorkerPool<T>::GetDatabaseName() const
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Execute(char const* sql)
+void DatabaseWorkerPool<T>::Execute(char const* sql, SQLOperationPriority priority /*= SQL_PRIORITY_SAVE*/)
 {
     if (Trinity::IsFormatEmptyOrNull(sql))
         return;
 
     BasicStatementTask* task = new BasicStatementTask(sql);
-    Enqueue(task);
+    Enqueue(task, priority);
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt)
+void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt, SQLOperationPriority priority /*= SQL_PRIORITY_SAVE*/)
 {
     PreparedStatementTask* task = new PreparedStatementTask(stmt);
-    Enqueue(task);
+    Enqueue(task, priority);
 }
 
 template <class T>
@@ -25,10 +25,10 @@
 #include <string>
 #include <vector>
 
-template <typename T>
-class ProducerConsumerQueue;
-
 class SQLOperation;
+class SQLOperationQueue;
+class QueryResultCache;
+struct SQLOperationQueueStats;
 struct MySQLConnectionInfo;
 
 template <class T>
@@ -68,7 +68,8 @@ class DatabaseWorkerPool
 
         //! Enqueues a one-way SQL operation in string format that will be executed asynchronously.
         //! This method should only be used for queries that are only executed once, e.g during startup.
-        void Execute(char const* sql);
+        //! Priority selects the queue lane, use SQL_PRIORITY_BACKGROUND for writes nobody waits on (logs, cleanups).
+        void Execute(char const* sql, SQLOperationPriority priority = SQL_PRIORITY_SAVE);
 
         //! Enqueues a one-way SQL operation in string format -with variable args- that will be executed asynchronously.
         //! This method should only be used for queries that are only executed once, e.g during startup.
@@ -83,7 +84,8 @@ class DatabaseWorkerPool
 
         //! Enqueues a one-way SQL operation in prepared statement format that will be executed asynchronously.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        void Execute(PreparedStatement<T>* stmt);
+        //! Priority selects the queue lane, use SQL_PRIORITY_BACKGROUND for writes nobody waits on (logs, cleanups).
+        void Execute(PreparedStatement<T>* stmt, SQLOperationPriority priority = SQL_PRIORITY_SAVE);
 
         /**
             Direct synchronous one-way statement methods.
@@ -143,6 +145,10 @@ class DatabaseWorkerPool
         //! Statement must be prepared with CONNECTION_SYNCH flag.
         PreparedQueryResult Query(PreparedStatement<T>* stmt);
 
+        //! Same as Query(PreparedStatement*) but repeated lookups with equal parameters are served from memory.
+        //! Only use for tables not written to at runtime, cached results are dropped by InvalidateQueryCache().
+        PreparedQueryResult CachedQuery(PreparedStatement<T>* stmt);
+
         /**
             Asynchronous query (with resultset) methods.
         */
@@ -154,13 +160,17 @@ class DatabaseWorkerPool
         //! Enqueues a query in prepared format that will set the value of the PreparedQueryResultFuture return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        QueryCallback AsyncQuery(PreparedStatement<T>* stmt);
+        //! Query starts after saves queued before it. With a non-zero order key it may pass saves keyed for other callers,
+        //! and will not start while a save or background operation with the same key is pending.
+        QueryCallback AsyncQuery(PreparedStatement<T>* stmt, uint32 orderKey = 0);
 
         //! Enqueues a vector of SQL operations (can be both adhoc and prepared) that will set the value of the QueryResultHolderFuture
         //! return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
-        SQLQueryHolderCallback DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder);
+        //! Holder starts after saves queued before it. With a non-zero order key it may pass saves keyed for other callers,
+        //! and will not start while a save or background operation with the same key is pending.
+        SQLQueryHolderCallback DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder, uint32 orderKey = 0);
 
         /**
             Transaction context methods.
@@ -171,7 +181,9 @@ class DatabaseWorkerPool
 
         //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
-        void CommitTransaction(SQLTransaction<T> transaction);
+        //! Priority selects the queue lane, use SQL_PRIORITY_BACKGROUND for writes nobody waits on (logs, cleanups).
+        //! Order key (e.g. account id) keeps higher priority operations of the same caller from overtaking it.
+        void CommitTransaction(SQLTransaction<T> transaction, SQLOperationPriority priority = SQL_PRIORITY_SAVE, uint32 orderKey = 0);
 
         //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
@@ -213,14 +225,24 @@ class DatabaseWorkerPool
 #endif
         }
 
+        //! Limits of results kept by CachedQuery(), maxEntries of 0 disables caching
+        void SetQueryCacheLimits(uint32 maxEntries, uint32 maxRowsPerResult);
+        void InvalidateQueryCache();
+        void InvalidateQueryCache(PreparedStatementIndex index);
+        uint32 GetQueryCacheSize() const;
+
         size_t QueueSize() const;
+        size_t QueueSize(SQLOperationPriority priority) const;
+
+        //! Returns per priority wait time statistics of async operations executed since previous call
+        SQLOperationQueueStats ResetQueueStats();
 
     private:
         uint32 OpenConnections(InternalIndex type, uint8 numConnections);
 
         unsigned long EscapeString(char* to, char const* from, unsigned long length);
 
-        void Enqueue(SQLOperation* op);
+        void Enqueue(SQLOperation* op, SQLOperationPriority priority, uint32 orderKey = 0);
 
         //! Gets a free connection in the synchronous connection pool.
         //! Caller MUST call t->Unlock() after touching the MySQL context to prevent deadlocks.
@@ -229,7 +251,8 @@ class DatabaseWorkerPool
         char const* GetDatabaseName() const;
 
         //! Queue shared by async worker threads.
-        std::unique_ptr<ProducerConsumerQueue<SQLOperation*>> _queue;
+        std::unique_ptr<SQLOperationQueue> _queue;
+        std::unique_ptr<QueryResultCache> _queryCache;
         std::array<std::vector<std::unique_ptr<T>>, IDX_SIZE> _connections;
         std::unique_ptr<MySQLConnectionInfo> _connectionInfo;
         std::vector<uint8> _preparedStatementSize;
@@ -127,7 +127,7 @@ public:
 
     //- Constructors for sync and async connections
     LoginDatabaseConnection(MySQLConnectionInfo& connInfo);
-    LoginDatabaseConnection(ProducerConsumerQueue<SQLOperation*>* q, MySQLConnectionInfo& connInfo);
+    LoginDatabaseConnection(SQLOperationQueue* q, MySQLConnectionInfo& connInfo);
     ~LoginDatabaseConnection();
 
     //- Loads database type specific prepared statements
@@ -29,6 +29,65 @@
 #include <errmsg.h>
 #include "MySQLWorkaround.h"
 #include <mysqld_error.h>
+#include <algorithm>
+#include <cctype>
+
+namespace
+{
+    // rows in one coalesced INSERT, parameter indexes are also limited to uint8
+    constexpr uint32 MAX_MULTI_ROW_INSERT_ROWS = 64;
+    constexpr uint32 MAX_MULTI_ROW_INSERT_PARAMS = 255;
+
+    // Splits "INSERT ... VALUES (?, ...)" into the part before the row and the row itself
+    // Fails for anything else, including INSERT ... SELECT and ON DUPLICATE KEY UPDATE clauses
+    bool ParseMultiRowInsert(std::string const& sql, std::string& prefix, std::string& row)
+    {
+        std::string upper(sql);
+        std::transform(upper.begin(), upper.end(), upper.begin(), [](char c) { return char(std::toupper(static_cast<unsigned char>(c))); });
+
+        std::size_t start = upper.find_first_not_of(" \t\r\n");
+        if (start == std::string::npos || (upper.compare(start, 6, "INSERT") != 0 && upper.compare(start, 7, "REPLACE") != 0))
+            return false;
+
+        std::size_t values = upper.rfind("VALUES");
+        if (values == std::string::npos)
+            return false;
+
+        std::size_t open = sql.find_first_not_of(" \t\r\n", values + 6);
+        if (open == std::string::npos || sql[open] != '(')
+            return false;
+
+        std::size_t close = std::string::npos;
+        int32 depth = 0;
+        char quote = 0;
+        for (std::size_t i = open; i < sql.size() && close == std::string::npos; ++i)
+        {
+            char c = sql[i];
+            if (quote)
+            {
+                if (c == quote)
+                    quote = 0;
+            }
+            else if (c == '\'' || c == '"' || c == '`')
+                quote = c;
+            else if (c == '(')
+                ++depth;
+            else if (c == ')' && !--depth)
+                close = i;
+        }
+
+        if (close == std::string::npos || sql.find_first_not_of(" \t\r\n;", close + 1) != std::string::npos)
+            return false;
+
+        // every parameter must be part of the row
+        if (sql.find('?') < open)
+            return false;
+
+        prefix = sql.substr(0, open);
+        row = sql.substr(open, close - open + 1);
+        return true;
+    }
+}
 
 MySQLConnectionInfo::MySQLConnectionInfo(std::string const& infoString)
 {
@@ -55,7 +114,7 @@ m_Mysql(nullptr),
 m_connectionInfo(connInfo),
 m_connectionFlags(CONNECTION_SYNCH) { }
 
-MySQLConnection::MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo) :
+MySQLConnection::MySQLConnection(SQLOperationQueue* queue, MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
 m_queue(queue),
@@ -76,6 +135,7 @@ void MySQLConnection::Close()
     // Stop the worker thread before the statements are cleared
     m_worker.reset();
 
+    m_multiRowInserts.clear();
     m_stmts.clear();
 
     if (m_Mysql)
@@ -182,6 +242,7 @@ uint32 MySQLConnection::Open()
 
 bool MySQLConnection::PrepareStatements()
 {
+    m_multiRowInserts.clear();
     DoPrepareStatements();
     return !m_prepareError;
 }
@@ -394,6 +455,7 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
 
     BeginTransaction();
 
+    std::vector<PreparedStatementBase*> run;
     for (auto itr = queries.begin(); itr != queries.end(); ++itr)
     {
         SQLElementData const& data = *itr;
@@ -403,7 +465,17 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
             {
                 PreparedStatementBase* stmt = data.element.stmt;
                 ASSERT(stmt);
-                if (!Execute(stmt))
+
+                // collect following uses of the same statement, they are sent together
+                run.assign(1, stmt);
+                while (std::next(itr) != queries.end() && std::next(itr)->type == SQL_ELEMENT_PREPARED
+                    && std::next(itr)->element.stmt->GetIndex() == stmt->GetIndex())
+                {
+                    ++itr;
+                    run.push_back(itr->element.stmt);
+                }
+
+                if (!ExecuteRun(run.data(), run.size()))
                 {
                     TC_LOG_WARN("sql.sql", "Transaction aborted. %u queries not executed.", (uint32)queries.size());
                     int errorCode = GetLastError();
@@ -437,6 +509,137 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
     return 0;
 }
 
+bool MySQLConnection::ExecuteRun(PreparedStatementBase* const* stmts, std::size_t count)
+{
+    std::size_t done = 0;
+    while (done < count)
+    {
+        uint32 rows = uint32(std::min<std::size_t>(count - done, MAX_MULTI_ROW_INSERT_ROWS));
+        if (rows > 1)
+        {
+            // looked up again every chunk, reconnecting clears multi-row statements
+            MultiRowInsert& insert = GetMultiRowInsert(stmts[done]->GetIndex());
+            if (insert.Valid)
+            {
+                // power of two row counts only, keeps the number of prepared variants low
+                uint32 chunk = 1;
+                while (chunk * 2 <= std::min(rows, insert.MaxRows))
+                    chunk *= 2;
+
+                if (chunk > 1)
+                {
+                    if (MySQLPreparedStatement* mStmt = GetMultiRowStatement(insert, chunk))
+                    {
+                        if (!ExecuteMultiRow(mStmt, stmts + done, chunk))
+                            return false;
+
+                        done += chunk;
+                        continue;
+                    }
+                }
+            }
+        }
+
+        if (!Execute(stmts[done]))
+            return false;
+
+        ++done;
+    }
+
+    return true;
+}
+
+bool MySQLConnection::ExecuteMultiRow(MySQLPreparedStatement* mStmt, PreparedStatementBase* const* stmts, std::size_t count)
+{
+    if (!m_Mysql)
+        return false;
+
+    mStmt->BindParameters(stmts, count);
+
+    MYSQL_STMT* msql_STMT = mStmt->GetSTMT();
+    MYSQL_BIND* msql_BIND = mStmt->GetBind();
+
+    uint32 _s = getMSTime();
+
+    if (mysql_stmt_bind_param(msql_STMT, msql_BIND) || mysql_stmt_execute(msql_STMT))
+    {
+        uint32 lErrno = mysql_errno(m_Mysql);
+        TC_LOG_ERROR("sql.sql", "SQL(p): %s (%u rows)\n [ERROR]: [%u] %s", mStmt->m_queryString.c_str(), uint32(count), lErrno, mysql_stmt_error(msql_STMT));
+
+        mStmt->ClearParameters();
+
+        // reconnecting destroys mStmt, retry rows one by one like Execute() does
+        if (_HandleMySQLErrno(lErrno))
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                if (!Execute(stmts[i]))
+                    return false;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    TC_LOG_DEBUG("sql.sql", "[%u ms] SQL(p): %s (%u rows)", getMSTimeDiff(_s, getMSTime()), mStmt->m_queryString.c_str(), uint32(count));
+
+    mStmt->ClearParameters();
+    return true;
+}
+
+MySQLConnection::MultiRowInsert& MySQLConnection::GetMultiRowInsert(uint32 index)
+{
+    auto itr = m_multiRowInserts.find(index);
+    if (itr != m_multiRowInserts.end())
+        return itr->second;
+
+    MultiRowInsert& insert = m_multiRowInserts[index];
+    MySQLPreparedStatement* mStmt = GetPreparedStatement(index);
+    if (!mStmt || !mStmt->GetParameterCount() || !ParseMultiRowInsert(mStmt->m_queryString, insert.Prefix, insert.Row))
+        return insert;
+
+    if (uint32(std::count(insert.Row.begin(), insert.Row.end(), '?')) != mStmt->GetParameterCount())
+        return insert;
+
+    insert.MaxRows = std::min(MAX_MULTI_ROW_INSERT_ROWS, MAX_MULTI_ROW_INSERT_PARAMS / mStmt->GetParameterCount());
+    insert.Valid = insert.MaxRows > 1;
+    return insert;
+}
+
+MySQLPreparedStatement* MySQLConnection::GetMultiRowStatement(MultiRowInsert& insert, uint32 rows)
+{
+    auto itr = insert.Statements.find(rows);
+    if (itr != insert.Statements.end())
+        return itr->second.get();
+
+    std::string sql = insert.Prefix;
+    sql.reserve(insert.Prefix.size() + rows * (insert.Row.size() + 2));
+    for (uint32 i = 0; i < rows; ++i)
+    {
+        if (i)
+            sql += ", ";
+        sql += insert.Row;
+    }
+
+    MYSQL_STMT* stmt = mysql_stmt_init(m_Mysql);
+    if (!stmt)
+        return nullptr;
+
+    if (mysql_stmt_prepare(stmt, sql.c_str(), static_cast<unsigned long>(sql.size())))
+    {
+        // not worth retrying, fall back to single rows for this statement
+        TC_LOG_ERROR("sql.sql", "In mysql_stmt_prepare() for %u rows, sql: \"%s\"", rows, sql.c_str());
+        TC_LOG_ERROR("sql.sql", "%s", mysql_stmt_error(stmt));
+        mysql_stmt_close(stmt);
+        insert.Valid = false;
+        return nullptr;
+    }
+
+    std::unique_ptr<MySQLPreparedStatement>& mStmt = insert.Statements[rows];
+    mStmt = std::make_unique<MySQLPreparedStatement>(reinterpret_cast<MySQLStmt*>(stmt), std::move(sql));
+    return mStmt.get();
+}
+
 size_t MySQLConnection::EscapeString(char* to, const char* from, size_t length)
 {
     return mysql_real_escape_string(m_Mysql, to, from, length);
@@ -24,14 +24,13 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
-template <typename T>
-class ProducerConsumerQueue;
-
 class DatabaseWorker;
 class MySQLPreparedStatement;
 class SQLOperation;
+class SQLOperationQueue;
 
 enum ConnectionFlags
 {
@@ -59,7 +58,7 @@ class TC_DATABASE_API MySQLConnection
 
     public:
         MySQLConnection(MySQLConnectionInfo& connInfo);                               //! Constructor for synchronous connections.
-        MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo);  //! Constructor for asynchronous connections.
+        MySQLConnection(SQLOperationQueue* queue, MySQLConnectionInfo& connInfo);  //! Constructor for asynchronous connections.
         virtual ~MySQLConnection();
 
         virtual uint32 Open();
@@ -106,12 +105,29 @@ class TC_DATABASE_API MySQLConnection
     private:
         bool _HandleMySQLErrno(uint32 errNo, uint8 attempts = 5);
 
-        ProducerConsumerQueue<SQLOperation*>* m_queue;      //! Queue shared with other asynchronous connections.
+        //! Prepared INSERT that can be repeated into multi-row statements
+        struct MultiRowInsert
+        {
+            bool Valid = false;
+            uint32 MaxRows = 0;
+            std::string Prefix;                 //! everything before the row
+            std::string Row;                    //! "(?, ...)"
+            std::map<uint32 /*rows*/, std::unique_ptr<MySQLPreparedStatement>> Statements;
+        };
+
+        //! Executes consecutive uses of the same prepared statement, INSERTs are sent as multi-row statements
+        bool ExecuteRun(PreparedStatementBase* const* stmts, std::size_t count);
+        bool ExecuteMultiRow(MySQLPreparedStatement* mStmt, PreparedStatementBase* const* stmts, std::size_t count);
+        MultiRowInsert& GetMultiRowInsert(uint32 index);
+        MySQLPreparedStatement* GetMultiRowStatement(MultiRowInsert& insert, uint32 rows);
+
+        SQLOperationQueue* m_queue;      //! Queue shared with other asynchronous connections.
         std::unique_ptr<DatabaseWorker> m_worker;           //! Core worker task.
         MySQLHandle*          m_Mysql;                      //! MySQL Handle.
         MySQLConnectionInfo&  m_connectionInfo;             //! Connection info (used for logging)
         ConnectionFlags       m_connectionFlags;            //! Connection flags (for preparing relevant statements)
         std::mutex            m_Mutex;
+        std::unordered_map<uint32, MultiRowInsert> m_multiRowInserts;  //! Multi-row variants of prepared statements, by statement index
 
         MySQLConnection(MySQLConnection const& right) = delete;
         MySQLConnection& operator=(MySQLConnection const& right) = delete;
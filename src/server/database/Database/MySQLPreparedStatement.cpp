@@ -63,20 +63,28 @@ MySQLPreparedStatement::~MySQLPreparedStatement()
 
 void MySQLPreparedStatement::BindParameters(PreparedStatementBase* stmt)
 {
-    m_stmt = stmt;     // Cross reference them for debug output
+    BindParameters(&stmt, 1);
+}
 
+void MySQLPreparedStatement::BindParameters(PreparedStatementBase* const* stmts, std::size_t count)
+{
     uint8 pos = 0;
-    for (PreparedStatementData const& data : stmt->GetParameters())
+    for (std::size_t i = 0; i < count; ++i)
     {
-        std::visit([&](auto&& param)
+        m_stmt = stmts[i];     // Cross reference them for debug output
+
+        for (PreparedStatementData const& data : m_stmt->GetParameters())
         {
-            SetParameter(pos, param);
-        }, data.data);
-        ++pos;
+            std::visit([&](auto&& param)
+            {
+                SetParameter(pos, param);
+            }, data.data);
+            ++pos;
+        }
     }
 #ifdef _DEBUG
     if (pos < m_paramCount)
-        TC_LOG_WARN("sql.sql", "[WARNING]: BindParameters() for statement %u did not bind all allocated parameters", stmt->GetIndex());
+        TC_LOG_WARN("sql.sql", "[WARNING]: BindParameters() for statement %u did not bind all allocated parameters", m_stmt->GetIndex());
 #endif
 }
 
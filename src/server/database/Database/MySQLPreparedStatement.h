@@ -40,6 +40,8 @@ class TC_DATABASE_API MySQLPreparedStatement
         ~MySQLPreparedStatement();
 
         void BindParameters(PreparedStatementBase* stmt);
+        //- Binds parameters of count statements one after another, for statements repeating their row count times
+        void BindParameters(PreparedStatementBase* const* stmts, std::size_t count);
 
         uint32 GetParameterCount() const { return m_paramCount; }
 
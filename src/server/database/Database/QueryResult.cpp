@@ -311,6 +311,19 @@ m_metadataResult(result)
     mysql_stmt_free_result(m_stmt);
 }
 
+PreparedResultSet::PreparedResultSet(std::shared_ptr<PreparedResultSet const> source) :
+m_rows(source->m_rows),
+m_rowCount(source->m_rowCount),
+m_rowPosition(0),
+m_fieldCount(source->m_fieldCount),
+m_rBind(nullptr),
+m_stmt(nullptr),
+m_metadataResult(nullptr),
+m_source(std::move(source))
+{
+    /// Fields keep pointing at buffers and metadata of the source result set
+}
+
 ResultSet::~ResultSet()
 {
     CleanUp();
@@ -55,6 +55,8 @@ class TC_DATABASE_API PreparedResultSet
 {
     public:
         PreparedResultSet(MySQLStmt* stmt, MySQLResult* result, uint64 rowCount, uint32 fieldCount);
+        //! New cursor over rows of another result set, which is kept alive by it
+        explicit PreparedResultSet(std::shared_ptr<PreparedResultSet const> source);
         ~PreparedResultSet();
 
         bool NextRow();
@@ -75,6 +77,7 @@ class TC_DATABASE_API PreparedResultSet
         MySQLBind* m_rBind;
         MySQLStmt* m_stmt;
         MySQLResult* m_metadataResult;    ///< Field metadata, returned by mysql_stmt_result_metadata
+        std::shared_ptr<PreparedResultSet const> m_source; ///< Owner of row data and field metadata of a shared cursor
 
         void CleanUp();
         bool _NextRow();
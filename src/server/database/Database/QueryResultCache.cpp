@@ -0,0 +1,164 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "QueryResultCache.h"
+#include "PreparedStatement.h"
+#include "QueryResult.h"
+#include <type_traits>
+
+namespace
+{
+    template<typename T>
+    void AppendBytes(std::string& key, T const& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only raw values can be appended");
+        key.append(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    struct KeyAppender
+    {
+        std::string& Key;
+
+        template<typename T>
+        void operator()(T const& value) const { AppendBytes(Key, value); }
+
+        void operator()(std::string const& value) const
+        {
+            AppendBytes(Key, uint32(value.size()));
+            Key.append(value);
+        }
+
+        void operator()(std::vector<uint8> const& value) const
+        {
+            AppendBytes(Key, uint32(value.size()));
+            Key.append(reinterpret_cast<char const*>(value.data()), value.size());
+        }
+
+        void operator()(std::nullptr_t) const { }
+    };
+}
+
+QueryResultCache::QueryResultCache() : _maxEntries(0), _maxRowsPerResult(0)
+{
+}
+
+void QueryResultCache::SetLimits(uint32 maxEntries, uint32 maxRowsPerResult)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    _maxEntries = maxEntries;
+    _maxRowsPerResult = maxRowsPerResult;
+
+    while (_entries.size() > _maxEntries)
+    {
+        _lookup.erase(_entries.back().Key);
+        _entries.pop_back();
+    }
+}
+
+bool QueryResultCache::Get(PreparedStatementBase const* stmt, PreparedQueryResult& result)
+{
+    std::string key = BuildKey(stmt);
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    auto itr = _lookup.find(key);
+    if (itr == _lookup.end())
+        return false;
+
+    _entries.splice(_entries.begin(), _entries, itr->second);
+    result = NewCursor(itr->second->Result);
+    return true;
+}
+
+void QueryResultCache::Store(PreparedStatementBase const* stmt, PreparedQueryResult const& result)
+{
+    std::string key = BuildKey(stmt);
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    if (!_maxEntries || (result && result->GetRowCount() > _maxRowsPerResult))
+        return;
+
+    auto itr = _lookup.find(key);
+    if (itr != _lookup.end())
+    {
+        itr->second->Result = result;
+        _entries.splice(_entries.begin(), _entries, itr->second);
+        return;
+    }
+
+    if (_entries.size() >= _maxEntries)
+    {
+        _lookup.erase(_entries.back().Key);
+        _entries.pop_back();
+    }
+
+    _entries.push_front({ key, stmt->GetIndex(), result });
+    _lookup.emplace(std::move(key), _entries.begin());
+}
+
+void QueryResultCache::Invalidate()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    _entries.clear();
+    _lookup.clear();
+}
+
+void QueryResultCache::Invalidate(uint32 index)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    for (EntryList::iterator itr = _entries.begin(); itr != _entries.end();)
+    {
+        if (itr->Index == index)
+        {
+            _lookup.erase(itr->Key);
+            itr = _entries.erase(itr);
+        }
+        else
+            ++itr;
+    }
+}
+
+uint32 QueryResultCache::GetSize() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return uint32(_entries.size());
+}
+
+std::string QueryResultCache::BuildKey(PreparedStatementBase const* stmt)
+{
+    std::string key;
+    AppendBytes(key, stmt->GetIndex());
+    for (PreparedStatementData const& param : stmt->GetParameters())
+    {
+        // type is part of the key, setUInt32(0, 1) and setUInt8(0, 1) may select different rows
+        AppendBytes(key, uint8(param.data.index()));
+        std::visit(KeyAppender{ key }, param.data);
+    }
+    return key;
+}
+
+PreparedQueryResult QueryResultCache::NewCursor(PreparedQueryResult const& result)
+{
+    if (!result)
+        return nullptr;
+
+    return std::make_shared<PreparedResultSet>(result);
+}
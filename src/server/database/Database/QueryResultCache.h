@@ -0,0 +1,70 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _QUERYRESULTCACHE_H
+#define _QUERYRESULTCACHE_H
+
+#include "Define.h"
+#include "DatabaseEnvFwd.h"
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+//! Size limited LRU cache of prepared statement results, keyed by statement index and parameter values.
+//! Every hit returns a new cursor sharing rows of the cached result, so callers iterate independently.
+//! Empty results are cached as well (as null result), most runtime lookups are existence checks.
+class TC_DATABASE_API QueryResultCache
+{
+public:
+    QueryResultCache();
+
+    //! maxEntries of 0 disables the cache, results of more than maxRowsPerResult rows are never cached
+    void SetLimits(uint32 maxEntries, uint32 maxRowsPerResult);
+    bool IsEnabled() const { return _maxEntries != 0; }
+
+    bool Get(PreparedStatementBase const* stmt, PreparedQueryResult& result);
+    void Store(PreparedStatementBase const* stmt, PreparedQueryResult const& result);
+
+    void Invalidate();
+    void Invalidate(uint32 index);
+
+    uint32 GetSize() const;
+
+private:
+    struct Entry
+    {
+        std::string Key;
+        uint32 Index;
+        PreparedQueryResult Result;
+    };
+    typedef std::list<Entry> EntryList;
+
+    static std::string BuildKey(PreparedStatementBase const* stmt);
+    static PreparedQueryResult NewCursor(PreparedQueryResult const& result);
+
+    EntryList _entries;                                         //! Most recently used first
+    std::unordered_map<std::string, EntryList::iterator> _lookup;
+    uint32 _maxEntries;
+    uint32 _maxRowsPerResult;
+    mutable std::mutex _lock;
+
+    QueryResultCache(QueryResultCache const& right) = delete;
+    QueryResultCache& operator=(QueryResultCache const& right) = delete;
+};
+
+#endif
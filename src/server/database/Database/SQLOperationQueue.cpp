@@ -0,0 +1,258 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SQLOperationQueue.h"
+#include "Errors.h"
+#include "SQLOperation.h"
+#include <algorithm>
+
+namespace
+{
+    //! Number of times in a row a non-empty lane may be passed over for higher priority lanes before it is served anyway
+    constexpr std::array<uint32, MAX_SQL_PRIORITY> STARVATION_LIMITS = { 0, 4, 16 };
+
+    //! Entries of a lane looked at when its head is held back by order key
+    constexpr int32 ORDER_KEY_SCAN_LIMIT = 32;
+}
+
+SQLOperationQueue::SQLOperationQueue() : _sequence(0), _interactiveWaiters(0), _reservedWorkers(0), _registeredWorkers(0), _blocked(false), _shutdown(false)
+{
+}
+
+SQLOperationQueue::~SQLOperationQueue()
+{
+    Cancel();
+}
+
+void SQLOperationQueue::Push(SQLOperation* op, SQLOperationPriority priority, uint32 orderKey)
+{
+    ASSERT(priority < MAX_SQL_PRIORITY);
+
+    std::lock_guard<std::mutex> lock(_lock);
+    Lane& lane = _lanes[priority];
+    uint64 const sequence = ++_sequence;
+    lane.Entries.push_back({ op, orderKey, priority, sequence, std::chrono::steady_clock::now() });
+    lane.Size.store(lane.Entries.size(), std::memory_order_relaxed);
+
+    if (orderKey)
+        ++_pendingKeys[orderKey][priority];
+
+    if (priority == SQL_PRIORITY_SAVE)
+    {
+        _pendingSaves.insert(sequence);
+        if (!orderKey)
+            _pendingUnkeyedSaves.insert(sequence);
+    }
+
+    // prefer waking an idle reserved worker for interactive operations, it cannot take anything else anyway
+    if (priority == SQL_PRIORITY_INTERACTIVE && _interactiveWaiters)
+        _interactiveCondition.notify_one();
+    else
+        _condition.notify_one();
+}
+
+bool SQLOperationQueue::WaitAndPop(uint32 worker, Entry& entry)
+{
+    std::unique_lock<std::mutex> lock(_lock);
+
+    bool const interactiveOnly = worker < _reservedWorkers;
+    uint32 lane = 0;
+    int32 index = 0;
+    while (!_shutdown && !SelectEntry(interactiveOnly, lane, index))
+    {
+        if (interactiveOnly)
+        {
+            ++_interactiveWaiters;
+            _interactiveCondition.wait(lock);
+            --_interactiveWaiters;
+        }
+        else
+            _condition.wait(lock);
+    }
+
+    if (_shutdown)
+        return false;
+
+    Pop(lane, index, entry);
+    return true;
+}
+
+void SQLOperationQueue::Complete(Entry const& entry)
+{
+    if (!entry.OrderKey && entry.Priority != SQL_PRIORITY_SAVE)
+        return;
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    if (entry.Priority == SQL_PRIORITY_SAVE)
+    {
+        _pendingSaves.erase(entry.Sequence);
+        _pendingUnkeyedSaves.erase(entry.Sequence);
+    }
+
+    if (entry.OrderKey)
+    {
+        // canceled meanwhile
+        PendingKeysMap::iterator itr = _pendingKeys.find(entry.OrderKey);
+        if (itr != _pendingKeys.end())
+        {
+            --itr->second[entry.Priority];
+            if (std::all_of(itr->second.begin(), itr->second.end(), [](uint32 count) { return count == 0; }))
+                _pendingKeys.erase(itr);
+        }
+    }
+
+    if (_blocked)
+    {
+        _blocked = false;
+        _condition.notify_all();
+        _interactiveCondition.notify_all();
+    }
+}
+
+void SQLOperationQueue::Cancel()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    for (Lane& lane : _lanes)
+    {
+        for (Entry const& entry : lane.Entries)
+            delete entry.Operation;
+
+        lane.Entries.clear();
+        lane.Size.store(0, std::memory_order_relaxed);
+    }
+
+    _pendingKeys.clear();
+    _pendingSaves.clear();
+    _pendingUnkeyedSaves.clear();
+    _shutdown = true;
+
+    _condition.notify_all();
+    _interactiveCondition.notify_all();
+}
+
+size_t SQLOperationQueue::Size() const
+{
+    size_t size = 0;
+    for (Lane const& lane : _lanes)
+        size += lane.Size.load(std::memory_order_relaxed);
+    return size;
+}
+
+SQLOperationQueueStats SQLOperationQueue::ResetStats()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    SQLOperationQueueStats stats;
+    for (uint32 i = 0; i < MAX_SQL_PRIORITY; ++i)
+    {
+        stats.Lanes[i] = _lanes[i].Stats;
+        _lanes[i].Stats = SQLOperationQueueStats::Lane();
+    }
+    return stats;
+}
+
+bool SQLOperationQueue::CanStart(Entry const& entry) const
+{
+    // reads see every save queued before them, keyed reads may only pass keyed saves (of other callers, checked below)
+    if (entry.Priority == SQL_PRIORITY_INTERACTIVE)
+    {
+        std::set<uint64> const& earlierSaves = entry.OrderKey ? _pendingUnkeyedSaves : _pendingSaves;
+        if (!earlierSaves.empty() && *earlierSaves.begin() < entry.Sequence)
+            return false;
+    }
+
+    if (!entry.OrderKey)
+        return true;
+
+    PendingKeysMap::const_iterator itr = _pendingKeys.find(entry.OrderKey);
+    if (itr == _pendingKeys.end())
+        return true;
+
+    for (uint32 i = entry.Priority + 1; i < MAX_SQL_PRIORITY; ++i)
+        if (itr->second[i])
+            return false;
+
+    return true;
+}
+
+int32 SQLOperationQueue::FindStartable(uint32 lane) const
+{
+    std::deque<Entry> const& entries = _lanes[lane].Entries;
+    int32 const limit = std::min<int32>(int32(entries.size()), ORDER_KEY_SCAN_LIMIT);
+    for (int32 i = 0; i < limit; ++i)
+        if (CanStart(entries[i]))
+            return i;
+
+    return -1;
+}
+
+bool SQLOperationQueue::SelectEntry(bool interactiveOnly, uint32& lane, int32& index)
+{
+    uint32 const lanes = interactiveOnly ? SQL_PRIORITY_INTERACTIVE + 1 : MAX_SQL_PRIORITY;
+    std::array<int32, MAX_SQL_PRIORITY> startable;
+    startable.fill(-1);
+
+    bool queued = false;
+    lane = MAX_SQL_PRIORITY;
+    for (uint32 i = 0; i < lanes; ++i)
+    {
+        if (_lanes[i].Entries.empty())
+            continue;
+
+        queued = true;
+        startable[i] = FindStartable(i);
+        if (startable[i] < 0)
+            continue;
+
+        if (lane == MAX_SQL_PRIORITY)
+            lane = i;
+        // a starved lower priority lane takes precedence
+        else if (_lanes[i].Skipped >= STARVATION_LIMITS[i])
+            lane = i;
+    }
+
+    if (lane == MAX_SQL_PRIORITY)
+    {
+        // everything queued waits for operations executing on other workers
+        if (queued)
+            _blocked = true;
+        return false;
+    }
+
+    for (uint32 i = lane + 1; i < lanes; ++i)
+        if (startable[i] >= 0)
+            ++_lanes[i].Skipped;
+
+    index = startable[lane];
+    return true;
+}
+
+void SQLOperationQueue::Pop(uint32 lane, int32 index, Entry& entry)
+{
+    Lane& from = _lanes[lane];
+    entry = from.Entries[index];
+    from.Entries.erase(from.Entries.begin() + index);
+    from.Size.store(from.Entries.size(), std::memory_order_relaxed);
+    from.Skipped = 0;
+
+    uint64 wait = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - entry.QueuedTime).count();
+    ++from.Stats.Operations;
+    from.Stats.TotalWait += wait;
+    from.Stats.MaxWait = std::max(from.Stats.MaxWait, wait);
+}
@@ -0,0 +1,129 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SQLOPERATIONQUEUE_H
+#define _SQLOPERATIONQUEUE_H
+
+#include "Define.h"
+#include "DatabaseEnvFwd.h"
+#include "Duration.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+class SQLOperation;
+
+//! Wait time statistics of operations popped from each priority lane
+struct SQLOperationQueueStats
+{
+    struct Lane
+    {
+        uint64 Operations = 0;  //! Operations popped since last ResetStats()
+        uint64 TotalWait = 0;   //! Sum of time spent queued, in microseconds
+        uint64 MaxWait = 0;     //! Longest time spent queued, in microseconds
+    };
+
+    std::array<Lane, MAX_SQL_PRIORITY> Lanes;
+};
+
+//! Queue shared by async worker threads of a DatabaseWorkerPool.
+//! Every priority class has its own FIFO lane, workers always serve the highest priority lane first
+//! unless a lower lane has been passed over too many times in a row (starvation limit).
+//! Operations sharing a non-zero order key (per caller queue, e.g. account id) never start while
+//! one with the same key is pending in a lower priority lane, so a login load cannot overtake
+//! the logout save of the same account.
+//! Interactive operations never start before save lane operations queued earlier, unless both carry
+//! a non-zero order key and the keys differ: a keyed read only passes saves of other callers.
+//! The first workers to register can be reserved for SQL_PRIORITY_INTERACTIVE operations so
+//! login and other player facing loads never wait behind a save wave.
+class TC_DATABASE_API SQLOperationQueue
+{
+public:
+    struct Entry
+    {
+        SQLOperation* Operation;
+        uint32 OrderKey;
+        SQLOperationPriority Priority;
+        uint64 Sequence;
+        TimePoint QueuedTime;
+    };
+
+    SQLOperationQueue();
+    ~SQLOperationQueue();
+
+    //! Number of workers (in registration order) that only serve SQL_PRIORITY_INTERACTIVE operations.
+    //! Must be set before workers register.
+    void SetReservedWorkers(uint32 count) { _reservedWorkers = count; }
+
+    //! Returns worker ordinal to pass to WaitAndPop()
+    uint32 RegisterWorker() { return _registeredWorkers++; }
+
+    void Push(SQLOperation* op, SQLOperationPriority priority, uint32 orderKey);
+
+    //! Blocks until an operation the worker may serve can start, returns false once canceled.
+    bool WaitAndPop(uint32 worker, Entry& entry);
+
+    //! Must be called once the popped operation has been executed.
+    void Complete(Entry const& entry);
+
+    void Cancel();
+
+    size_t Size() const;
+    size_t Size(SQLOperationPriority priority) const { return _lanes[priority].Size.load(std::memory_order_relaxed); }
+
+    SQLOperationQueueStats ResetStats();
+
+private:
+    struct Lane
+    {
+        std::deque<Entry> Entries;
+        std::atomic<size_t> Size{ 0 };
+        uint32 Skipped = 0;
+        SQLOperationQueueStats::Lane Stats;
+    };
+
+    //! Operations queued or executing per order key and lane
+    typedef std::unordered_map<uint32, std::array<uint32, MAX_SQL_PRIORITY>> PendingKeysMap;
+
+    bool CanStart(Entry const& entry) const;
+    int32 FindStartable(uint32 lane) const;
+    bool SelectEntry(bool interactiveOnly, uint32& lane, int32& index);
+    void Pop(uint32 lane, int32 index, Entry& entry);
+
+    std::array<Lane, MAX_SQL_PRIORITY> _lanes;
+    PendingKeysMap _pendingKeys;
+    std::set<uint64> _pendingSaves;                 //! Sequence of save lane operations queued or executing
+    std::set<uint64> _pendingUnkeyedSaves;          //! Same, only those without order key
+    uint64 _sequence;
+    mutable std::mutex _lock;
+    std::condition_variable _condition;             //! Waited on by workers serving all lanes
+    std::condition_variable _interactiveCondition;  //! Waited on by reserved workers
+    uint32 _interactiveWaiters;
+    std::atomic<uint32> _reservedWorkers;
+    std::atomic<uint32> _registeredWorkers;
+    bool _blocked;                                  //! A worker waits only because of order keys
+    bool _shutdown;
+
+    SQLOperationQueue(SQLOperationQueue const& right) = delete;
+    SQLOperationQueue& operator=(SQLOperationQueue const& right) = delete;
+};
+
+#endif
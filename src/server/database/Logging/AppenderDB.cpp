@@ -37,7 +37,7 @@ void AppenderDB::_write(LogMessage const* message)
     stmt->setString(2, message->type);
     stmt->setUInt8(3, uint8(message->level));
     stmt->setString(4, message->text);
-    LoginDatabase.Execute(stmt);
+    LoginDatabase.Execute(stmt, SQL_PRIORITY_BACKGROUND);
 }
 
 void AppenderDB::setRealmId(uint32 _realmId)
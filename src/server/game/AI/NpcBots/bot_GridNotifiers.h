@@ -2,13 +2,17 @@
 #define _BOT_GRIDNOTIFIERS_H
 
 #include "bot_ai.h"
+#include "botperception.h"
 #include "botspell.h"
+#include "CellImpl.h"
 #include "Corpse.h"
 #include "Creature.h"
 #include "DBCStores.h"
 #include "DynamicObject.h"
 #include "GameObject.h"
+#include "GridNotifiers.h"
 #include "Group.h"
+#include "Map.h"
 #include "ObjectAccessor.h"
 #include "Player.h"
 #include "Spell.h"
@@ -63,6 +67,34 @@ struct Unit2LastSearcher
     template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
 };
 
+//Same as Trinity::UnitListSearcher + Cell::VisitAllObjects() but served from map's bot perception cache if possible
+//Check must not add units to the map
+template<class Check>
+void VisitNearbyUnitsCached(WorldObject const* searcher, WorldObject const* center, std::list<Unit*>& units, Check& check, float radius)
+{
+    CellArea area;
+    Map const* map = center->GetMap();
+    if (BotPerceptionCache::CandidateVec const* candidates = map->GetBotPerceptionCache()->GetCandidates(center, radius, area))
+    {
+        uint32 const phaseMask = searcher->GetPhaseMask();
+        for (BotPerceptionCache::Candidate const& candidate : *candidates)
+        {
+            //units gathered earlier this update may have left the map or moved out of searched cells since
+            Unit* unit = candidate.unit;
+            if (!unit->IsInWorld() || unit->GetMap() != map)
+                continue;
+            if (!BotPerceptionCache::IsInArea(area, Trinity::ComputeCellCoord(unit->GetPositionX(), unit->GetPositionY())))
+                continue;
+            if (unit->InSamePhase(phaseMask) && check(unit))
+                units.push_back(unit);
+        }
+        return;
+    }
+
+    Trinity::UnitListSearcher<Check> listSearcher(searcher, units, check);
+    Cell::VisitAllObjects(center, listSearcher, radius);
+}
+
 class ImmunityShieldDispelTargetCheck
 {
     public:
@@ -247,6 +247,10 @@ bot_ai::bot_ai(Creature* creature) : CreatureAI(creature)
 
     _wmoAreaUpdateTimer = 0;
 
+    _updateTier = BOT_UPDATE_TIER_END;
+    _updateTierTimer = 0;
+    _updateTierDiff = 0;
+
     _ownerGuid = 0;
 
     _wanderer = false;
@@ -279,6 +283,8 @@ bot_ai::~bot_ai()
 
     delete _classinfo;
 
+    _setUpdateTier(BOT_UPDATE_TIER_END);
+
     BotDataMgr::UnregisterBot(me);
 }
 
@@ -445,7 +451,7 @@ void bot_ai::CheckOwnerExpiry()
     if (!BotMgr::GetOwnershipExpireTime())
         return; //disabled
 
-    NpcBotData const* npcBotData = BotDataMgr::SelectNpcBotData(me->GetEntry());
+    NpcBotDataPtr npcBotData = BotDataMgr::SelectNpcBotData(me->GetEntry());
     ASSERT(npcBotData, "bot_ai::CheckOwnerExpiry(): data not found!");
 
     NpcBotExtras const* npcBotExtra = BotDataMgr::SelectNpcBotExtras(me->GetEntry());
@@ -4264,8 +4270,7 @@ std::tuple<Unit*, Unit*> bot_ai::_getTargets(bool byspell, bool ranged, bool &re
     std::array<std::pair<Unit*, float>, 2> ts{};
     std::list<Unit*> unitList;
     NearestHostileUnitCheck check(me, maxdist, byspell, this);
-    Trinity::UnitListSearcher searcher(master->ToUnit(), unitList, check);
-    Cell::VisitAllObjects(HasBotCommandState(BOT_COMMAND_STAY) ? me->ToUnit() : master->ToUnit(), searcher, maxdist);
+    VisitNearbyUnitsCached(master, HasBotCommandState(BOT_COMMAND_STAY) ? me->ToUnit() : master->ToUnit(), unitList, check, maxdist);
 
     if (IAmFree())
     {
@@ -5843,8 +5848,7 @@ Unit* bot_ai::FindHostileDispelTarget(float dist, bool stealable) const
     std::list<Unit*> unitList;
 
     HostileDispelTargetCheck check(me, dist, stealable, this);
-    Trinity::UnitListSearcher <HostileDispelTargetCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, dist);
+    VisitNearbyUnitsCached(me, me, unitList, check, dist);
     //me->VisitNearbyObject(dist, searcher);
 
     if (unitList.empty())
@@ -5889,8 +5893,7 @@ Unit* bot_ai::FindPolyTarget(float dist) const
     std::list<Unit*> unitList;
 
     PolyUnitCheck check(me, dist);
-    Trinity::UnitListSearcher <PolyUnitCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, dist);
+    VisitNearbyUnitsCached(me, me, unitList, check, dist);
     //me->VisitNearbyObject(dist, searcher);
 
     if (unitList.empty())
@@ -5906,8 +5909,7 @@ Unit* bot_ai::FindFearTarget(float dist) const
     std::list<Unit*> unitList;
 
     FearUnitCheck check(me, dist);
-    Trinity::UnitListSearcher <FearUnitCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, dist);
+    VisitNearbyUnitsCached(me, me, unitList, check, dist);
     //me->VisitNearbyObject(dist, searcher);
 
     if (unitList.empty())
@@ -5923,8 +5925,7 @@ Unit* bot_ai::FindStunTarget(float dist) const
     std::list<Unit*> unitList;
 
     StunUnitCheck check(me, dist);
-    Trinity::UnitListSearcher <StunUnitCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, dist);
+    VisitNearbyUnitsCached(me, me, unitList, check, dist);
     //me->VisitNearbyObject(dist, searcher);
 
     if (unitList.empty())
@@ -5943,8 +5944,7 @@ Unit* bot_ai::FindUndeadCCTarget(float dist, uint32 spellId, bool unattacked) co
     std::list<Unit*> unitList;
 
     UndeadCCUnitCheck check(me, dist, this, spellId, unattacked);
-    Trinity::UnitListSearcher <UndeadCCUnitCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, dist);
+    VisitNearbyUnitsCached(me, me, unitList, check, dist);
     //me->VisitNearbyObject(dist, searcher);
 
     if (unitList.empty())
@@ -5963,8 +5963,7 @@ Unit* bot_ai::FindRootTarget(float dist, uint32 spellId) const
     std::list<Unit*> unitList;
 
     RootUnitCheck check(me, dist, this, spellId);
-    Trinity::UnitListSearcher <RootUnitCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, dist);
+    VisitNearbyUnitsCached(me, me, unitList, check, dist);
     //me->VisitNearbyObject(dist, searcher);
 
     if (unitList.empty())
@@ -5981,8 +5980,7 @@ Unit* bot_ai::FindCastingTarget(float maxdist, float mindist, uint32 spellId, ui
     std::list<Unit*> unitList;
 
     CastingUnitCheck check(me, mindist, maxdist, spellId, minHpPct);
-    Trinity::UnitListSearcher <CastingUnitCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, maxdist);
+    VisitNearbyUnitsCached(me, me, unitList, check, maxdist);
     //me->VisitNearbyObject(maxdist, searcher);
 
     if (unitList.empty())
@@ -6083,8 +6081,7 @@ Unit* bot_ai::FindSplashTarget(float dist, Unit* To, float splashdist, uint8 min
     std::list<Unit*> unitList;
 
     SecondEnemyCheck check(me, dist, splashdist, To, this);
-    Trinity::UnitListSearcher <SecondEnemyCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, dist);
+    VisitNearbyUnitsCached(me, me, unitList, check, dist);
     //me->VisitNearbyObject(dist, searcher);
 
     if (uint8(unitList.size()) < minTargets)
@@ -6113,8 +6110,7 @@ Unit* bot_ai::FindDistantTauntTarget(float maxdist, bool ally) const
     std::list<Unit*> unitList;
 
     FarTauntUnitCheck check(me, maxdist, ally, this);
-    Trinity::UnitListSearcher <FarTauntUnitCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, maxdist);
+    VisitNearbyUnitsCached(me, me, unitList, check, maxdist);
     //me->VisitNearbyObject(maxdist, searcher);
 
     if (unitList.empty())
@@ -6147,8 +6143,7 @@ void bot_ai::GetNearbyTargetsList(std::list<Unit*> &targets, float maxdist, uint
         source = me;
 
     NearbyHostileUnitCheck check(me, maxdist, this, CCoption, source);
-    Trinity::UnitListSearcher <NearbyHostileUnitCheck> searcher(me, targets, check);
-    Cell::VisitAllObjects(me, searcher, maxdist);
+    VisitNearbyUnitsCached(me, me, targets, check, maxdist);
     //me->VisitNearbyObject(maxdist, searcher);
 }
 //Find all targets within given range in cone in front of caster; angle is PI/2 (TC confirmed)
@@ -6157,8 +6152,7 @@ void bot_ai::GetNearbyTargetsList(std::list<Unit*> &targets, float maxdist, uint
 void bot_ai::GetNearbyTargetsInConeList(std::list<Unit*> &targets, float maxdist) const
 {
     NearbyHostileUnitInConeCheck check(me, maxdist, this);
-    Trinity::UnitListSearcher <NearbyHostileUnitInConeCheck> searcher(me, targets, check);
-    Cell::VisitAllObjects(me, searcher, maxdist);
+    VisitNearbyUnitsCached(me, me, targets, check, maxdist);
     //me->VisitNearbyObject(maxdist, searcher);
 }
 //Finds all friendly targets within given range
@@ -6166,8 +6160,7 @@ void bot_ai::GetNearbyTargetsInConeList(std::list<Unit*> &targets, float maxdist
 void bot_ai::GetNearbyFriendlyTargetsList(std::list<Unit*> &targets, float maxdist) const
 {
     NearbyFriendlyUnitCheck check(me, maxdist, this);
-    Trinity::UnitListSearcher <NearbyFriendlyUnitCheck> searcher(me, targets, check);
-    Cell::VisitAllObjects(me, searcher, maxdist);
+    VisitNearbyUnitsCached(me, me, targets, check, maxdist);
     //me->VisitNearbyObject(maxdist, searcher);
 }
 //////////
@@ -6227,7 +6220,7 @@ void bot_ai::InitSpellMap(uint32 basespell, bool forceadd, bool forwardRank)
 
     newSpell->spellId = spellId;
 
-    NpcBotData const* npcBotData = BotDataMgr::SelectNpcBotData(me->GetEntry());
+    NpcBotDataPtr npcBotData = BotDataMgr::SelectNpcBotData(me->GetEntry());
     if (npcBotData && npcBotData->disabled_spells.find(basespell) != npcBotData->disabled_spells.end())
     {
         newSpell->enabled = false;
@@ -6386,7 +6379,8 @@ void bot_ai::RemoveSpell(uint32 basespell)
 //}
 void bot_ai::EnableAllSpells()
 {
-    NpcBotData* npcBotData = const_cast<NpcBotData*>(BotDataMgr::SelectNpcBotData(me->GetEntry()));
+    NpcBotDataPtr botDataPtr = BotDataMgr::SelectNpcBotData(me->GetEntry());
+    NpcBotData* npcBotData = const_cast<NpcBotData*>(botDataPtr.get());
     npcBotData->disabled_spells.clear();
     _saveDisabledSpells = true;
 
@@ -9020,7 +9014,8 @@ bool bot_ai::OnGossipSelect(Player* player, Creature* creature/* == me*/, uint32
         case GOSSIP_SENDER_ABILITIES_USAGE_TOGGLE_HEAL:
         case GOSSIP_SENDER_ABILITIES_USAGE_TOGGLE_SUPPORT:
         {
-            NpcBotData* npcBotData = const_cast<NpcBotData*>(BotDataMgr::SelectNpcBotData(me->GetEntry()));
+            NpcBotDataPtr botDataPtr = BotDataMgr::SelectNpcBotData(me->GetEntry());
+            NpcBotData* npcBotData = const_cast<NpcBotData*>(botDataPtr.get());
 
             uint32 basespell = action - GOSSIP_ACTION_INFO_DEF;
             BotSpellMap const& myspells = GetSpellMap();
@@ -13633,7 +13628,7 @@ void bot_ai::ApplyRacials()
 
 void bot_ai::InitFaction()
 {
-    NpcBotData const* npcBotData = BotDataMgr::SelectNpcBotData(me->GetEntry());
+    NpcBotDataPtr npcBotData = BotDataMgr::SelectNpcBotData(me->GetEntry());
     ASSERT(npcBotData, "bot_ai::InitFaction(): data not found!");
 
     uint32 faction = npcBotData->faction;
@@ -13657,7 +13652,7 @@ void bot_ai::InitRace()
 
 void bot_ai::InitOwner()
 {
-    NpcBotData const* npcBotData = BotDataMgr::SelectNpcBotData(me->GetEntry());
+    NpcBotDataPtr npcBotData = BotDataMgr::SelectNpcBotData(me->GetEntry());
     ASSERT(npcBotData, "bot_ai::InitOwner(): data not found!");
 
     _ownerGuid = npcBotData->owner;
@@ -13685,7 +13680,7 @@ void bot_ai::InitRoles()
         return;
     }
 
-    NpcBotData const* npcBotData = BotDataMgr::SelectNpcBotData(me->GetEntry());
+    NpcBotDataPtr npcBotData = BotDataMgr::SelectNpcBotData(me->GetEntry());
     ASSERT(npcBotData, "bot_ai::InitRoles(): data not found!");
 
     _roleMask = npcBotData->roles;
@@ -13761,7 +13756,7 @@ void bot_ai::InitSpec()
     }
     else
     {
-        NpcBotData const* npcBotData = BotDataMgr::SelectNpcBotData(me->GetEntry());
+        NpcBotDataPtr npcBotData = BotDataMgr::SelectNpcBotData(me->GetEntry());
         ASSERT(npcBotData, "bot_ai::InitSpec(): data not found!");
 
         spec = npcBotData->spec;
@@ -14008,7 +14003,7 @@ void bot_ai::InitEquips()
     EquipmentInfo const* einfo = BotDataMgr::GetBotEquipmentInfo(me->GetEntry());
     ASSERT(einfo, "Trying to spawn bot with no equip info!");
 
-    NpcBotData const* npcBotData = BotDataMgr::SelectNpcBotData(me->GetEntry());
+    NpcBotDataPtr npcBotData = BotDataMgr::SelectNpcBotData(me->GetEntry());
     ASSERT(npcBotData, "bot_ai::InitEquips(): data not found!");
 
     PreparedQueryResult iiresult;
@@ -16134,7 +16129,8 @@ bool bot_ai::GlobalUpdate(uint32 diff)
 
         if (!IsTempBot())
         {
-            NpcBotData* npcBotData = const_cast<NpcBotData*>(BotDataMgr::SelectNpcBotData(me->GetEntry()));
+            NpcBotDataPtr botDataPtr = BotDataMgr::SelectNpcBotData(me->GetEntry());
+            NpcBotData* npcBotData = const_cast<NpcBotData*>(botDataPtr.get());
             BotDataMgr::UpdateNpcBotData(me->GetEntry(), NPCBOT_UPDATE_DISABLED_SPELLS, &npcBotData->disabled_spells);
         }
     }
@@ -16411,7 +16407,7 @@ bool bot_ai::GlobalUpdate(uint32 diff)
         if (me->GetDisplayId() == me->GetNativeDisplayId())
         {
             me->SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, DEFAULT_PLAYER_BOUNDING_RADIUS * me->GetObjectScale());
-            me->SetFloatValue(UNIT_FIELD_COMBATREACH,  DEFAULT_PLAYER_COMBAT_REACH * me->GetObjectScale());
+            me->SetCombatReach(DEFAULT_PLAYER_COMBAT_REACH * me->GetObjectScale());
 
             //debug: restore offhand visual if needed
             if (me->GetUInt32Value(UNIT_VIRTUAL_ITEM_SLOT_ID + BOT_SLOT_OFFHAND) == 0 && _canUseOffHand())
@@ -16799,6 +16795,66 @@ void bot_ai::CommonTimers(uint32 diff)
 
     if (_saveDisabledSpellsTimer > diff) _saveDisabledSpellsTimer -= diff;
 }
+//AI level of detail
+//Bots nobody is looking at don't need to think every map update. Instead, diff is accumulated
+//and UpdateAI is called once per tier interval with accumulated diff so all timers stay correct
+bool bot_ai::CanUpdateAI(uint32 diff, uint32& aiDiff)
+{
+    _updateTierDiff += diff;
+    aiDiff = _updateTierDiff;
+
+    if (!BotMgr::IsUpdateLODEnabled())
+    {
+        _setUpdateTier(BOT_UPDATE_TIER_END);
+        _updateTierDiff = 0;
+        return true;
+    }
+
+    //wake up immediately if attacked
+    if (_updateTierTimer <= diff || (_updateTier != BOT_UPDATE_TIER_COMBAT && (me->IsInCombat() || me->GetVictim())))
+    {
+        _updateTierTimer = BOT_UPDATE_TIER_CHECK_TIMER;
+        _setUpdateTier(_calculateUpdateTier());
+    }
+    else
+        _updateTierTimer -= diff;
+
+    if (_updateTierDiff < BotMgr::GetUpdateLODInterval(_updateTier))
+        return false;
+
+    _updateTierDiff = 0;
+    return true;
+}
+
+uint8 bot_ai::_calculateUpdateTier() const
+{
+    if (me->IsInCombat() || me->GetVictim() || IsDuringTeleport())
+        return BOT_UPDATE_TIER_COMBAT;
+
+    if (!IAmFree())
+        return master->IsInCombat() ? BOT_UPDATE_TIER_COMBAT : BOT_UPDATE_TIER_NEAR;
+
+    if (!me->GetMap()->HavePlayers())
+        return BOT_UPDATE_TIER_DORMANT;
+
+    Player* player = nullptr;
+    Trinity::AnyPlayerInObjectRangeCheck check(me, BotMgr::GetUpdateLODNearDistance(), false);
+    Trinity::PlayerSearcher<Trinity::AnyPlayerInObjectRangeCheck> searcher(me, player, check);
+    Cell::VisitWorldObjects(me, searcher, BotMgr::GetUpdateLODNearDistance());
+    if (player)
+        return BOT_UPDATE_TIER_NEAR;
+
+    return me->GetMap()->GetZonePlayerCount(me->GetZoneId()) ? BOT_UPDATE_TIER_FAR : BOT_UPDATE_TIER_DORMANT;
+}
+
+void bot_ai::_setUpdateTier(uint8 tier)
+{
+    if (_updateTier == tier)
+        return;
+
+    BotMgr::OnBotUpdateTierChanged(_updateTier, tier);
+    _updateTier = tier;
+}
 
 void bot_ai::UpdateReviveTimer(uint32 diff)
 {
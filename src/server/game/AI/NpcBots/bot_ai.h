@@ -104,6 +104,8 @@ class bot_ai : public CreatureAI
         virtual void UpdateDeadAI(uint32 /*diff*/) {}
         void ReturnHome() { _atHome = false; }
         void CommonTimers(uint32 diff);
+        bool CanUpdateAI(uint32 diff, uint32& aiDiff);
+        uint8 GetUpdateTier() const { return _updateTier; }
         void ResetBotAI(uint8 resetType);
         void KillEvents(bool force);
         void BotMovement(BotMovementType type, Position const* pos, Unit* target = nullptr, bool generatePath = true) const;
@@ -523,6 +525,9 @@ class bot_ai : public CreatureAI
         void _OnZoneUpdate(uint32 zoneId, uint32 areaId);
         void _OnAreaUpdate(uint32 areaId);
 
+        uint8 _calculateUpdateTier() const;
+        void _setUpdateTier(uint8 tier);
+
         void RemoveItemBonuses(uint8 slot);
         void RemoveItemEnchantments(Item const* item);
         void RemoveItemEnchantment(Item const* item, EnchantmentSlot eslot);
@@ -629,6 +634,7 @@ class bot_ai : public CreatureAI
         uint32 _reviveTimer, _powersTimer, _chaseTimer, _engageTimer, _potionTimer;
         uint32 lastdiff, checkAurasTimer, checkMasterTimer, roleTimer, ordersTimer, regenTimer, _updateTimerMedium, _updateTimerEx1;
         uint32 _wmoAreaUpdateTimer;
+        uint32 _updateTierTimer, _updateTierDiff;
         uint32 waitTimer;
         uint32 itemsAutouseTimer;
         uint32 evadeDelayTimer;
@@ -637,6 +643,8 @@ class bot_ai : public CreatureAI
 
         uint32 _lastZoneId, _lastAreaId, _lastWMOAreaId;
 
+        uint8 _updateTier;
+
         uint8 _unreachableCount, _jumpCount, _evadeCount;
         uint32 _roleMask;
         uint32 _usableItemSlotsMask;
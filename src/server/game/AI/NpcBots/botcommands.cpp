@@ -1859,7 +1859,7 @@ public:
     {
         uint32 count = 0;
         for (uint32 creature_id : BotDataMgr::GetExistingNPCBotIds())
-            if (NpcBotData const* botData = BotDataMgr::SelectNpcBotData(creature_id))
+            if (NpcBotDataPtr botData = BotDataMgr::SelectNpcBotData(creature_id))
                 if (botData->owner == 0)
                     if (HandleNpcBotDeleteByIdCommand(handler, creature_id))
                         ++count;
@@ -2172,8 +2172,7 @@ public:
 
     static bool HandleNpcBotSpawnedCommand(ChatHandler* handler)
     {
-        std::unique_lock<std::shared_mutex> lock(*BotDataMgr::GetLock());
-        NpcBotRegistry const& all_bots = BotDataMgr::GetExistingNPCBots();
+        NpcBotRegistry const all_bots = BotDataMgr::GetExistingNPCBots();
         std::stringstream ss;
         if (all_bots.empty())
             ss << "No spawned bots found!";
@@ -2205,8 +2204,7 @@ public:
 
     static bool HandleNpcBotSpawnedFreeCommand(ChatHandler* handler)
     {
-        std::unique_lock<std::shared_mutex> lock(*BotDataMgr::GetLock());
-        NpcBotRegistry const& all_bots = BotDataMgr::GetExistingNPCBots();
+        NpcBotRegistry const all_bots = BotDataMgr::GetExistingNPCBots();
         //using std::remove_if with sets requires c++20
         std::vector<NpcBotRegistry::value_type> free_bots;
         free_bots.reserve(all_bots.size());
@@ -2238,6 +2236,14 @@ public:
             }
         }
 
+        if (BotMgr::IsUpdateLODEnabled())
+        {
+            ss << "\nUpdate tiers: combat " << BotMgr::GetBotsCountByUpdateTier(BOT_UPDATE_TIER_COMBAT)
+                << ", near " << BotMgr::GetBotsCountByUpdateTier(BOT_UPDATE_TIER_NEAR)
+                << ", far " << BotMgr::GetBotsCountByUpdateTier(BOT_UPDATE_TIER_FAR)
+                << ", dormant " << BotMgr::GetBotsCountByUpdateTier(BOT_UPDATE_TIER_DORMANT);
+        }
+
         handler->SendSysMessage(ss.str().c_str());
         return true;
     }
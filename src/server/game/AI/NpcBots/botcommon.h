@@ -522,6 +522,17 @@ enum BotAwaitStates
 
 constexpr size_t MAX_SEND_POINTS = 5u;
 
+//AI level of detail, lower tier is updated more often
+enum BotUpdateTiers : uint8
+{
+    BOT_UPDATE_TIER_COMBAT              = 0, // bot or its owner is fighting
+    BOT_UPDATE_TIER_NEAR,                    // owned bot or a player is close enough to watch
+    BOT_UPDATE_TIER_FAR,                     // players are in the zone but out of sight
+    BOT_UPDATE_TIER_DORMANT,                 // no players around at all
+    BOT_UPDATE_TIER_END
+};
+constexpr uint32 BOT_UPDATE_TIER_CHECK_TIMER = 2000; //ms
+
 #define FROM_ARRAY(arr) arr, arr + sizeof(arr) / sizeof(arr[0])
 
 //Only non-persistent types are allowed
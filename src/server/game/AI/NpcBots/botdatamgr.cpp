@@ -10,9 +10,20 @@
 #include "Log.h"
 #include "Map.h"
 #include "MapManager.h"
+#include "Metric.h"
 #include "ObjectMgr.h"
 #include "StringConvert.h"
 #include "WorldDatabase.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 /*
 Npc Bot Data Manager by Trickerer (onlysuffering@gmail.com)
 NpcBots DB Data management
@@ -23,15 +34,139 @@ NpcBots DB Data management
 # pragma warning(push, 4)
 #endif
 
-typedef std::unordered_map<uint32 /*entry*/, NpcBotData*> NpcBotDataMap;
+//Read-copy-update storage split into shards by bot entry.
+//Writers copy one shard, modify the copy and publish it. Readers keep thread-local references to
+//last seen snapshots and only reload a shard after its version changes, so reading never writes shared memory.
+//Values dropped from a shard stay alive as long as any reader still holds an older snapshot of it
+template<class Container>
+class BotShardedSnapshot
+{
+    public:
+        typedef std::shared_ptr<Container const> SnapshotPtr;
+        static constexpr uint32 SHARDS = 16;
+
+        BotShardedSnapshot()
+        {
+            for (Shard& shard : _shards)
+            {
+                shard.snapshot = std::make_shared<Container const>();
+                shard.version.store(1, std::memory_order_relaxed);
+            }
+        }
+
+        static uint32 GetShard(uint32 entry) { return entry % SHARDS; }
+
+        //returned reference stays valid until next Read() of the same shard by this thread
+        SnapshotPtr const& Read(uint32 shardId) const
+        {
+            struct ReaderCache
+            {
+                BotShardedSnapshot const* owner = nullptr;
+                std::array<uint32, SHARDS> versions{};
+                std::array<SnapshotPtr, SHARDS> snapshots;
+            };
+            thread_local ReaderCache cache;
+
+            if (cache.owner != this)
+            {
+                cache.owner = this;
+                cache.versions.fill(0);
+            }
+
+            Shard const& shard = _shards[shardId];
+            uint32 version = shard.version.load(std::memory_order_acquire);
+            if (cache.versions[shardId] != version)
+            {
+                cache.snapshots[shardId] = std::atomic_load(&shard.snapshot);
+                cache.versions[shardId] = version;
+            }
+            return cache.snapshots[shardId];
+        }
+
+        template<class Modifier>
+        void Write(uint32 shardId, Modifier&& modifier)
+        {
+            Shard& shard = _shards[shardId];
+            std::lock_guard<std::mutex> lock(shard.writeLock);
+            std::shared_ptr<Container> copy = std::make_shared<Container>(*std::atomic_load(&shard.snapshot));
+            modifier(*copy);
+            std::atomic_store(&shard.snapshot, SnapshotPtr(std::move(copy)));
+            shard.version.fetch_add(1, std::memory_order_release);
+        }
+
+    private:
+        //each shard on its own cache line so publishing one doesn't disturb readers of the others
+        struct alignas(64) Shard
+        {
+            SnapshotPtr snapshot;
+            std::atomic<uint32> version;
+            std::mutex writeLock;
+        };
+        std::array<Shard, SHARDS> _shards;
+};
+
+typedef std::unordered_map<uint32 /*entry*/, std::shared_ptr<NpcBotData>> NpcBotDataMap;
 typedef std::unordered_map<uint32 /*entry*/, NpcBotAppearanceData*> NpcBotAppearanceDataMap;
 typedef std::unordered_map<uint32 /*entry*/, NpcBotExtras*> NpcBotExtrasMap;
 typedef std::unordered_map<uint32 /*entry*/, NpcBotTransmogData*> NpcBotTransmogDataMap;
-NpcBotDataMap _botsData;
+BotShardedSnapshot<NpcBotDataMap> _botsData;
 NpcBotAppearanceDataMap _botsAppearanceData;
 NpcBotExtrasMap _botsExtras;
 NpcBotTransmogDataMap _botsTransmogData;
-NpcBotRegistry _existingBots;
+//spawned bots by creature, guid is kept to look bots up by entry without touching the creature
+typedef std::unordered_map<Creature const*, ObjectGuid> NpcBotRegistryShard;
+BotShardedSnapshot<NpcBotRegistryShard> _existingBots;
+
+//Write-behind journal for frequent bot data updates.
+//Only the latest statement per bot and column is kept, pending statements are saved in a single transaction
+//so after a crash journaled columns are as of last flush and never partially updated.
+//Equips are not journaled: they are saved with item_instance rows taken from player inventory and must not lag behind player saves,
+//so after a crash bot equips can be newer than other bot data
+enum NpcBotDataJournalColumns : uint32
+{
+    BOT_JOURNAL_OWNER                   = 0,
+    BOT_JOURNAL_ROLES                   = 1,
+    BOT_JOURNAL_SPEC                    = 2,
+    BOT_JOURNAL_FACTION                 = 3,
+    BOT_JOURNAL_DISABLED_SPELLS         = 4,
+    BOT_JOURNAL_TRANSMOG_BEGIN          = 5 //+ transmog slot
+};
+typedef std::pair<uint32 /*entry*/, uint32 /*column*/> NpcBotDataJournalKey;
+typedef std::map<NpcBotDataJournalKey, CharacterDatabasePreparedStatement*> NpcBotDataJournal;
+NpcBotDataJournal _dataJournal;
+std::mutex _dataJournalLock;
+uint32 _dataJournalFlushTimer = 0;
+std::atomic<uint64> _dataJournalStatementsSaved(0);
+
+//takes ownership of stmt if journal is enabled, otherwise caller has to execute it
+static bool _journalStatement(uint32 entry, uint32 column, CharacterDatabasePreparedStatement* stmt)
+{
+    if (!BotMgr::GetDataJournalFlushInterval())
+        return false;
+
+    std::lock_guard<std::mutex> lock(_dataJournalLock);
+    CharacterDatabasePreparedStatement*& pending = _dataJournal[{ entry, column }];
+    if (pending)
+    {
+        delete pending;
+        _dataJournalStatementsSaved.fetch_add(1, std::memory_order_relaxed);
+    }
+    pending = stmt;
+    return true;
+}
+
+//drops pending statements superseded by immediate DELETE
+static void _journalDiscard(uint32 entry, uint32 columnBegin)
+{
+    std::lock_guard<std::mutex> lock(_dataJournalLock);
+    NpcBotDataJournal::iterator itr = _dataJournal.lower_bound({ entry, columnBegin });
+    while (itr != _dataJournal.end() && itr->first.first == entry)
+    {
+        delete itr->second;
+        _dataJournalStatementsSaved.fetch_add(1, std::memory_order_relaxed);
+        itr = _dataJournal.erase(itr);
+    }
+}
 
 CreatureTemplateContainer _botsWanderCreatureTemplates;
 std::unordered_map<uint32, EquipmentInfo const*> _botsWanderCreatureEquipmentTemplates;
@@ -54,14 +189,13 @@ static constexpr std::array wanderMapIds{ 0u, 1u };
 
 static bool allBotsLoaded = false;
 
+//Wander graph compiled into contiguous arrays per map.
+//Next node candidates are precomputed per node and level band so picking next node is a table lookup
 class BotTravelGraph
 {
 public:
-    ~BotTravelGraph() {
-        //order
-        Tops.clear();
-        Nodes.clear();
-    }
+    static constexpr uint32 INVALID_INDEX = std::numeric_limits<uint32>::max();
+    static constexpr uint32 NODE_LEVELS = std::numeric_limits<uint8>::max() + 1;
 
     struct BotTravelNode : public WorldLocation
     {
@@ -76,21 +210,185 @@ public:
         uint8 minlevel;
         uint8 maxlevel;
         std::string name;
+    };
 
-        std::vector<BotTravelNode*> connections;
+    struct ChoiceRange
+    {
+        uint32 begin;
+        uint32 count;
     };
 
-    std::unordered_map<uint32 /*mapId*/, std::unordered_map<uint32, BotTravelNode>> Nodes;
-    std::vector<BotTravelNode*> Tops; // single connection nodes
+    struct BotTravelMap
+    {
+        std::vector<BotTravelNode> Nodes;
+        std::unordered_map<uint32 /*nodeId*/, uint32 /*index*/> Indexes;
+        //adjacency: connections of node i are Edges[EdgeOffsets[i]] ... Edges[EdgeOffsets[i + 1] - 1]
+        std::vector<uint32> EdgeOffsets;
+        std::vector<uint32> Edges;
+        //next node candidates: Choices[Ranges[LevelRanges[i * NODE_LEVELS + level]]], Choices[Ranges[LowestRanges[i]]]
+        std::vector<uint32> Choices;
+        std::vector<ChoiceRange> Ranges;
+        std::vector<uint32> LevelRanges;
+        std::vector<uint32> LowestRanges;
+
+        uint32 GetIndex(uint32 nodeId) const
+        {
+            auto const it = Indexes.find(nodeId);
+            return it != Indexes.cend() ? it->second : INVALID_INDEX;
+        }
+        uint32 GetConnectionsCount(uint32 index) const { return EdgeOffsets[index + 1] - EdgeOffsets[index]; }
 
-    // debug
-    static constexpr size_t sizeofNode = sizeof(BotTravelNode);
+        uint32 SelectChoice(ChoiceRange const& range, uint32 excludeIndex) const
+        {
+            if (range.count == 0)
+                return INVALID_INDEX;
+
+            //uniform among choices except excluded one, which can only be present once
+            uint32 const* choices = &Choices[range.begin];
+            uint32 r = urand(0, range.count - 1);
+            if (choices[r] != excludeIndex)
+                return choices[r];
+            if (range.count == 1)
+                return INVALID_INDEX;
+            uint32 r2 = urand(0, range.count - 2);
+            return choices[r2 >= r ? r2 + 1 : r2];
+        }
+
+        uint32 Compile(float maxDist, float& mindist, float& maxdist, uint32& tops);
+    };
+
+    std::unordered_map<uint32 /*mapId*/, BotTravelMap> Maps;
+    uint32 Tops = 0;
+
+    BotTravelMap* GetMap(uint32 mapId)
+    {
+        auto it = Maps.find(mapId);
+        return it != Maps.end() ? &it->second : nullptr;
+    }
 } static WanderMap;
 
+//connects nodes closer than maxDist, drops unconnected ones and builds lookup tables, returns number of ribs
+uint32 BotTravelGraph::BotTravelMap::Compile(float maxDist, float& mindist, float& maxdist, uint32& tops)
+{
+    uint32 const count = uint32(Nodes.size());
+    std::vector<std::vector<uint32>> connections(count);
+    uint32 ribs = 0;
+    for (uint32 i = 0; i != count; ++i)
+    {
+        for (uint32 j = i + 1; j != count; ++j)
+        {
+            float dist2d = Nodes[i].GetExactDist2d(Nodes[j]);
+            if (dist2d < maxDist)
+            {
+                mindist = std::min<float>(mindist, dist2d);
+                maxdist = std::max<float>(maxdist, dist2d);
+                connections[i].push_back(j);
+                connections[j].push_back(i);
+                ++ribs;
+            }
+        }
+    }
+
+    //remove unconnected nodes
+    std::vector<uint32> remap(count, INVALID_INDEX);
+    std::vector<BotTravelNode> nodes;
+    nodes.reserve(count);
+    for (uint32 i = 0; i != count; ++i)
+    {
+        if (!connections[i].empty())
+        {
+            remap[i] = uint32(nodes.size());
+            nodes.push_back(std::move(Nodes[i]));
+        }
+    }
+    for (uint32 i = 0; i != count; ++i)
+    {
+        if (remap[i] != INVALID_INDEX && remap[i] != i)
+            connections[remap[i]] = std::move(connections[i]);
+    }
+    Nodes = std::move(nodes);
+    connections.resize(Nodes.size());
+
+    Indexes.clear();
+    EdgeOffsets.assign(1, 0);
+    Edges.clear();
+    Choices.clear();
+    Ranges.clear();
+    LevelRanges.assign(Nodes.size() * NODE_LEVELS, 0);
+    LowestRanges.assign(Nodes.size(), 0);
+
+    for (uint32 i = 0; i != Nodes.size(); ++i)
+    {
+        Indexes[Nodes[i].id] = i;
+
+        std::vector<uint32>& cons = connections[i];
+        for (uint32& con : cons)
+        {
+            con = remap[con];
+            Edges.push_back(con);
+        }
+        EdgeOffsets.push_back(uint32(Edges.size()));
+
+        if (cons.size() == 1u)
+            ++tops;
+
+        //level bands: set of connections suitable for level only changes at these levels
+        std::vector<uint32> bands = { 0 };
+        uint8 minlevel = 255;
+        for (uint32 con : cons)
+        {
+            BotTravelNode const& cnode = Nodes[con];
+            bands.push_back(cnode.minlevel);
+            if (uint32(cnode.maxlevel) + 4 < NODE_LEVELS)
+                bands.push_back(cnode.maxlevel + 4);
+            if (cnode.maxlevel < minlevel)
+                minlevel = cnode.maxlevel;
+        }
+        std::sort(bands.begin(), bands.end());
+        bands.erase(std::unique(bands.begin(), bands.end()), bands.end());
+
+        for (uint32 b = 0; b != bands.size(); ++b)
+        {
+            uint32 const lvl = bands[b];
+            ChoiceRange range{ uint32(Choices.size()), 0 };
+            for (uint32 con : cons)
+            {
+                if (lvl >= Nodes[con].minlevel && lvl <= uint32(Nodes[con].maxlevel) + 3)
+                {
+                    Choices.push_back(con);
+                    ++range.count;
+                }
+            }
+            uint32 const end = (b + 1 < bands.size()) ? bands[b + 1] : NODE_LEVELS;
+            std::fill(LevelRanges.begin() + i * NODE_LEVELS + lvl, LevelRanges.begin() + i * NODE_LEVELS + end, uint32(Ranges.size()));
+            Ranges.push_back(range);
+        }
+
+        ChoiceRange lowest{ uint32(Choices.size()), 0 };
+        for (uint32 con : cons)
+        {
+            if (Nodes[con].maxlevel == minlevel)
+            {
+                Choices.push_back(con);
+                ++lowest.count;
+            }
+        }
+        LowestRanges[i] = uint32(Ranges.size());
+        Ranges.push_back(lowest);
+    }
+
+    for (uint32 i = 0; i != Nodes.size(); ++i)
+        if (GetConnectionsCount(i) == 1 && GetConnectionsCount(Edges[EdgeOffsets[i]]) == 1)
+            TC_LOG_INFO("server.loading", "Node pair %u-%u is isolated!", Nodes[i].id, Nodes[Edges[EdgeOffsets[i]]].id);
+
+    return ribs;
+}
+
 void GenerateWanderNodes()
 {
     using NodeType = BotTravelGraph::BotTravelNode;
 
+    std::unordered_map<uint32 /*mapId*/, std::vector<NodeType>> genNodes;
     for (GameTeleContainer::value_type const& tele_pair : sObjectMgr->GetGameTeleMap())
     {
         GameTele const& tele = tele_pair.second;
@@ -103,34 +401,33 @@ void GenerateWanderNodes()
         if (lvlmin == 0 || lvlmax == 0)
             continue;
 
-        WanderMap.Nodes[tele.mapId][tele_pair.first] = NodeType(tele.mapId, pos, tele_pair.first, teleZoneId, lvlmin, lvlmax, tele.name);
+        genNodes[tele.mapId].emplace_back(tele.mapId, pos, tele_pair.first, teleZoneId, lvlmin, lvlmax, tele.name);
     }
 
-    for (decltype(WanderMap.Nodes)::value_type& mapNodes1 : WanderMap.Nodes)
+    uint32 total_nodes = 0;
+    for (decltype(genNodes)::value_type& mapNodes1 : genNodes)
     {
-        for (decltype(mapNodes1.second)::iterator it = mapNodes1.second.begin(); it != mapNodes1.second.end();)
-        {
-            for (auto& nodepair2 : WanderMap.Nodes.at(it->second.m_mapId))
-            {
-                if (it->first == nodepair2.first)
-                    continue;
+        std::vector<NodeType>& nodes = mapNodes1.second;
 
-                float dist2d = it->second.GetExactDist2d(nodepair2.second);
-                if (dist2d < NODE_CONNECTION_DIST_MAX_GEN)
-                    it->second.connections.push_back(&nodepair2.second);
-            }
+        //decide for all nodes first, compacting the vector moves nodes other checks still need
+        std::vector<bool> keep(nodes.size(), false);
+        for (uint32 i = 0; i != nodes.size(); ++i)
+            for (uint32 j = 0; j != nodes.size() && !keep[i]; ++j)
+                keep[i] = i != j && nodes[i].GetExactDist2d(nodes[j]) < NODE_CONNECTION_DIST_MAX_GEN;
 
-            if (it->second.connections.empty())
-                it = mapNodes1.second.erase(it);
-            else
-                ++it;
+        uint32 kept = 0;
+        for (uint32 i = 0; i != nodes.size(); ++i)
+        {
+            if (!keep[i])
+                continue;
+            if (kept != i)
+                nodes[kept] = std::move(nodes[i]);
+            ++kept;
         }
+        nodes.erase(nodes.begin() + kept, nodes.end());
+        total_nodes += nodes.size();
     }
 
-    uint32 total_nodes = 0;
-    for (decltype(WanderMap.Nodes)::value_type& mapNodes1 : WanderMap.Nodes)
-        total_nodes += mapNodes1.second.size();
-
     if (total_nodes == 0)
     {
         TC_LOG_FATAL("server.loading", "Failed to generate wander points: no game_tele points added!");
@@ -143,11 +440,10 @@ void GenerateWanderNodes()
     ss.setf(std::ios_base::fixed);
     ss.precision(4);
     ss << "INSERT INTO creature_wander_nodes (id, mapid, zoneid, x, y, z, o, name) VALUES ";
-    for (auto const& vt : WanderMap.Nodes)
+    for (auto const& vt : genNodes)
     {
-        for (auto const& nvt : vt.second)
+        for (auto const& n : vt.second)
         {
-            auto const& n = nvt.second;
             ss << '('
                 << n.id << ',' << n.m_mapId << ',' << n.zoneId << ','
                 << n.m_positionX << ',' << n.m_positionY << ',' << n.m_positionZ << ',' << n.GetOrientation() << ','
@@ -167,8 +463,6 @@ void GenerateWanderNodes()
 
 void FillWanderMap()
 {
-    using NodeType = BotTravelGraph::BotTravelNode;
-
     //TC_LOG_INFO("server.loading", "Loading bot wander map...");
 
     uint32 botoldMSTime = getMSTime();
@@ -188,6 +482,7 @@ void FillWanderMap()
         ASSERT(false);
     }
 
+    WanderMap.Maps.reserve(wanderMapIds.size());
     do
     {
         Field* fields = wres->Fetch();
@@ -211,57 +506,21 @@ void FillWanderMap()
         float o          = fields[++index].GetFloat();
         std::string name = fields[++index].GetString();
 
-        WanderMap.Nodes[mapid][id] = NodeType(mapid, x, y, z, o, id, zoneId, lvlmin, lvlmax, name);
+        WanderMap.Maps[mapid].Nodes.emplace_back(mapid, x, y, z, o, id, zoneId, lvlmin, lvlmax, name);
 
     } while (wres->NextRow());
 
     uint32 total_connections = 0;
     float mindist = 50000.f;
     float maxdist = 0.f;
-    for (decltype(WanderMap.Nodes)::value_type& mapNodes1 : WanderMap.Nodes)
-    {
-        for (decltype(mapNodes1.second)::iterator it = mapNodes1.second.begin(); it != mapNodes1.second.end();)
-        {
-            for (auto& nodepair2 : WanderMap.Nodes.at(it->second.m_mapId))
-            {
-                if (it->first == nodepair2.first)
-                    continue;
-
-                float dist2d = it->second.GetExactDist2d(nodepair2.second);
-                if (dist2d < NODE_CONNECTION_DIST_MAX)
-                {
-                    if (dist2d < mindist)
-                        mindist = dist2d;
-                    if (dist2d > maxdist)
-                        maxdist = dist2d;
-
-                    it->second.connections.push_back(&nodepair2.second);
-                    if (nodepair2.second.connections.empty() ||
-                        std::find(std::cbegin(nodepair2.second.connections), std::cend(nodepair2.second.connections), &it->second) == nodepair2.second.connections.cend())
-                        ++total_connections;
-                }
-            }
-
-            if (it->second.connections.empty())
-                it = mapNodes1.second.erase(it);
-            else
-            {
-                if (it->second.connections.size() == 1u)
-                {
-                    WanderMap.Tops.push_back(&it->second);
-                    if (it->second.connections.front()->connections.size() == 1)
-                        TC_LOG_INFO("server.loading", "Node pair %u-%u is isolated!", it->second.id, it->second.connections.front()->id);
-                }
-                ++it;
-            }
-        }
-    }
+    for (decltype(WanderMap.Maps)::value_type& mapNodes : WanderMap.Maps)
+        total_connections += mapNodes.second.Compile(NODE_CONNECTION_DIST_MAX, mindist, maxdist, WanderMap.Tops);
 
     uint32 total_nodes = 0;
-    for (auto const& vt : WanderMap.Nodes)
+    for (auto const& vt : WanderMap.Maps)
     {
-        total_nodes += vt.second.size();
-        if (vt.second.empty())
+        total_nodes += vt.second.Nodes.size();
+        if (vt.second.Nodes.empty())
         {
             TC_LOG_FATAL("server.loading", "Failed to load wander points: no game_tele points added to map %u!", vt.first);
             ASSERT(false);
@@ -269,16 +528,10 @@ void FillWanderMap()
     }
 
     TC_LOG_INFO("server.loading", ">> Loaded %u bot wander nodes on %u maps (total %u ribs, %u tops) in %u ms",
-        total_nodes, uint32(WanderMap.Nodes.size()), total_connections, uint32(WanderMap.Tops.size()), GetMSTimeDiffToNow(botoldMSTime));
+        total_nodes, uint32(WanderMap.Maps.size()), total_connections, WanderMap.Tops, GetMSTimeDiffToNow(botoldMSTime));
     TC_LOG_INFO("server.loading", "Nodes distances: min = %.3f, max = %.3f", mindist, maxdist);
 }
 
-std::shared_mutex* BotDataMgr::GetLock()
-{
-    static std::shared_mutex _lock;
-    return &_lock;
-}
-
 bool BotDataMgr::AllBotsLoaded()
 {
     return allBotsLoaded;
@@ -387,8 +640,9 @@ void BotDataMgr::LoadNpcBots(bool spawn)
         std::set<uint32> botgrids;
         QueryResult infores;
         CreatureTemplate const* proto;
-        NpcBotData* botData;
+        std::shared_ptr<NpcBotData> botData;
         std::list<uint32> entryList;
+        std::array<NpcBotDataMap, BotShardedSnapshot<NpcBotDataMap>::SHARDS> loadedData;
 
         do
         {
@@ -397,7 +651,7 @@ void BotDataMgr::LoadNpcBots(bool spawn)
             uint32 entry =          field[  index].GetUInt32();
 
             //load data
-            botData = new NpcBotData(0, 0);
+            botData.reset(new NpcBotData(0, 0));
             botData->owner =        field[++index].GetUInt32();
             botData->roles =        field[++index].GetUInt32();
             botData->spec =         field[++index].GetUInt8();
@@ -414,11 +668,18 @@ void BotDataMgr::LoadNpcBots(bool spawn)
             }
 
             entryList.push_back(entry);
-            _botsData[entry] = botData;
+            loadedData[BotShardedSnapshot<NpcBotDataMap>::GetShard(entry)][entry] = botData;
             ++datacounter;
 
         } while (result->NextRow());
 
+        for (uint32 i = 0; i != loadedData.size(); ++i)
+        {
+            _botsData.Write(i, [&loadedData, i](NpcBotDataMap& dataMap) {
+                dataMap.insert(loadedData[i].cbegin(), loadedData[i].cend());
+            });
+        }
+
         TC_LOG_INFO("server.loading", ">> Loaded %u bot data entries", datacounter);
 
         if (spawn)
@@ -573,7 +834,7 @@ void BotDataMgr::GenerateWanderingBots()
     for (decltype(_botsExtras)::value_type const& vt : _botsExtras)
     {
         uint8 c = vt.second->bclass;
-        if (c != BOT_CLASS_NONE && c != BOT_CLASS_BM && BotMgr::IsClassEnabled(c) && _botsData.find(vt.first) == _botsData.end())
+        if (c != BOT_CLASS_NONE && c != BOT_CLASS_BM && BotMgr::IsClassEnabled(c) && !SelectNpcBotData(vt.first))
         {
             ASSERT(spareBotIdsPerClassMap.find(c) != spareBotIdsPerClassMap.cend());
             spareBotIdsPerClassMap.at(c).insert(vt.first);
@@ -625,7 +886,11 @@ void BotDataMgr::GenerateWanderingBots()
             spareBotIdsPerClassMap.erase(bclass);
     };
 
-    std::set<uint32> botgrids;
+    //bot data is published with one write per shard before the bots are spawned
+    std::array<NpcBotDataMap, BotShardedSnapshot<NpcBotDataMap>::SHARDS> generatedData;
+    std::vector<std::pair<uint32 /*entry*/, NodeType const*>> botSpawns;
+    botSpawns.reserve(WANDERING_BOTS_COUNT);
+
     for (int32 i = 0; i < int32(WANDERING_BOTS_COUNT); ++i) // i is unused as value
     {
         while (all_templates.find(++bot_id) != all_templates.cend()) {}
@@ -649,8 +914,8 @@ void BotDataMgr::GenerateWanderingBots()
         ChrRacesEntry const* rentry = sChrRacesStore.LookupEntry(orig_extras->race);
         uint32 bot_faction = (bot_class >= BOT_CLASS_EX_START) ? wbot_faction_for_ex_class.find(bot_class)->second : rentry ? rentry->FactionID : 14;
 
-        NpcBotData* bot_data = new NpcBotData(bot_ai::DefaultRolesForClass(bot_class), bot_faction, bot_ai::DefaultSpecForClass(bot_class));
-        _botsData[bot_id] = bot_data;
+        std::shared_ptr<NpcBotData> bot_data(new NpcBotData(bot_ai::DefaultRolesForClass(bot_class), bot_faction, bot_ai::DefaultSpecForClass(bot_class)));
+        generatedData[BotShardedSnapshot<NpcBotDataMap>::GetShard(bot_id)][bot_id] = bot_data;
         NpcBotExtras* bot_extras = new NpcBotExtras();
         bot_extras->bclass = bot_class;
         bot_extras->race = orig_extras->race;
@@ -674,12 +939,37 @@ void BotDataMgr::GenerateWanderingBots()
         NodeType const* spawnLoc = nullptr;
         do
         {
-            auto const& spair = Trinity::Containers::SelectRandomContainerElement(Trinity::Containers::SelectRandomContainerElement(WanderMap.Nodes).second);
-            if (spair.second.maxlevel >= GetMinLevelForBotClass(bot_class))
-                spawnLoc = &spair.second;
+            NodeType const& snode = Trinity::Containers::SelectRandomContainerElement(Trinity::Containers::SelectRandomContainerElement(WanderMap.Maps).second.Nodes);
+            if (snode.maxlevel >= GetMinLevelForBotClass(bot_class))
+                spawnLoc = &snode;
 
         } while (spawnLoc == nullptr);
 
+        TC_LOG_INFO("npcbots", "Spawning wandering bot: %s (%u) class %u race %u fac %u, location: mapId %u %s (%s)",
+            bot_template.Name.c_str(), bot_id, uint32(bot_extras->bclass), uint32(bot_extras->race), bot_data->faction,
+            spawnLoc->m_mapId, spawnLoc->ToString().c_str(), spawnLoc->name.c_str());
+
+        botSpawns.emplace_back(bot_id, spawnLoc);
+
+        remove_bot_orig_entry_from_available(bot_class, orig_template->Entry);
+    }
+
+    for (uint32 i = 0; i != generatedData.size(); ++i)
+    {
+        if (generatedData[i].empty())
+            continue;
+
+        _botsData.Write(i, [&generatedData, i](NpcBotDataMap& dataMap) {
+            dataMap.insert(generatedData[i].cbegin(), generatedData[i].cend());
+        });
+    }
+
+    std::set<uint32> botgrids;
+    for (std::pair<uint32, NodeType const*> const& botSpawn : botSpawns)
+    {
+        uint32 spawn_id = botSpawn.first;
+        NodeType const* spawnLoc = botSpawn.second;
+
         CellCoord c = Trinity::ComputeCellCoord(spawnLoc->m_positionX, spawnLoc->m_positionY);
         GridCoord g = Trinity::ComputeGridCoord(spawnLoc->m_positionX, spawnLoc->m_positionY);
         ASSERT(c.IsCoordValid(), "Invalid Cell coord!");
@@ -688,19 +978,16 @@ void BotDataMgr::GenerateWanderingBots()
         map->LoadGrid(spawnLoc->m_positionX, spawnLoc->m_positionY);
         ASSERT(!map->Instanceable(), map->GetDebugInfo().c_str());
 
-        TC_LOG_INFO("npcbots", "Spawning wandering bot: %s (%u) class %u race %u fac %u, location: mapId %u %s (%s)",
-            bot_template.Name.c_str(), bot_id, uint32(bot_extras->bclass), uint32(bot_extras->race), bot_data->faction,
-            spawnLoc->m_mapId, spawnLoc->ToString().c_str(), spawnLoc->name.c_str());
         Position spos;
         spos.Relocate(spawnLoc->m_positionX, spawnLoc->m_positionY, spawnLoc->m_positionZ, spawnLoc->GetOrientation());
         Creature* bot = new Creature();
-        if (!bot->Create(map->GenerateLowGuid<HighGuid::Unit>(), map, PHASEMASK_NORMAL, bot_id, spos))
+        if (!bot->Create(map->GenerateLowGuid<HighGuid::Unit>(), map, PHASEMASK_NORMAL, spawn_id, spos))
         {
             delete bot;
             TC_LOG_FATAL("server.loading", "Creature is not created!");
             ASSERT(false);
         }
-        if (!bot->LoadBotCreatureFromDB(0, map, true, true, bot_id, &spos))
+        if (!bot->LoadBotCreatureFromDB(0, map, true, true, spawn_id, &spos))
         {
             delete bot;
             TC_LOG_FATAL("server.loading", "Cannot load npcbot from DB!");
@@ -709,8 +996,6 @@ void BotDataMgr::GenerateWanderingBots()
 
         bot->GetBotAI()->SetTravelNodeCur(spawnLoc->id);
 
-        remove_bot_orig_entry_from_available(bot_class, orig_template->Entry);
-
         botgrids.insert(g.GetId());
     }
 
@@ -741,11 +1026,10 @@ EquipmentInfo const* BotDataMgr::GetBotEquipmentInfo(uint32 entry)
 void BotDataMgr::AddNpcBotData(uint32 entry, uint32 roles, uint8 spec, uint32 faction)
 {
     //botData must be allocated explicitly
-    NpcBotDataMap::iterator itr = _botsData.find(entry);
-    if (itr == _botsData.end())
+    if (!SelectNpcBotData(entry))
     {
-        NpcBotData* botData = new NpcBotData(roles, faction, spec);
-        _botsData[entry] = botData;
+        std::shared_ptr<NpcBotData> botData(new NpcBotData(roles, faction, spec));
+        _botsData.Write(_botsData.GetShard(entry), [entry, botData](NpcBotDataMap& dataMap) { dataMap[entry] = botData; });
 
         CharacterDatabasePreparedStatement* bstmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_NPCBOT);
         //"INSERT INTO characters_npcbot (entry, roles, spec, faction) VALUES (?, ?, ?, ?)", CONNECTION_ASYNC);
@@ -760,15 +1044,19 @@ void BotDataMgr::AddNpcBotData(uint32 entry, uint32 roles, uint8 spec, uint32 fa
 
     TC_LOG_ERROR("sql.sql", "BotMgr::AddNpcBotData(): trying to add new data but entry already exists! entry = %u", entry);
 }
-NpcBotData const* BotDataMgr::SelectNpcBotData(uint32 entry)
+//returned handle keeps data alive even if the bot is removed from a later snapshot
+NpcBotDataPtr BotDataMgr::SelectNpcBotData(uint32 entry)
 {
-    NpcBotDataMap::const_iterator itr = _botsData.find(entry);
-    return itr != _botsData.cend() ? itr->second : nullptr;
+    NpcBotDataMap const& dataMap = *_botsData.Read(_botsData.GetShard(entry));
+    NpcBotDataMap::const_iterator itr = dataMap.find(entry);
+    return itr != dataMap.cend() ? itr->second : nullptr;
 }
 void BotDataMgr::UpdateNpcBotData(uint32 entry, NpcBotDataUpdateType updateType, void* data)
 {
-    NpcBotDataMap::iterator itr = _botsData.find(entry);
-    if (itr == _botsData.end())
+    //data itself is updated in place, only adding or erasing entries publishes new snapshot
+    BotShardedSnapshot<NpcBotDataMap>::SnapshotPtr const dataMap = _botsData.Read(_botsData.GetShard(entry));
+    NpcBotDataMap::const_iterator itr = dataMap->find(entry);
+    if (itr == dataMap->cend())
         return;
 
     CharacterDatabasePreparedStatement* bstmt;
@@ -782,10 +1070,12 @@ void BotDataMgr::UpdateNpcBotData(uint32 entry, NpcBotDataUpdateType updateType,
             //"UPDATE characters_npcbot SET owner = ? WHERE entry = ?", CONNECTION_ASYNC
             bstmt->setUInt32(0, itr->second->owner);
             bstmt->setUInt32(1, entry);
-            CharacterDatabase.Execute(bstmt);
+            if (!_journalStatement(entry, BOT_JOURNAL_OWNER, bstmt))
+                CharacterDatabase.Execute(bstmt);
             //break; //no break: erase transmogs
         [[fallthrough]];
         case NPCBOT_UPDATE_TRANSMOG_ERASE:
+            _journalDiscard(entry, BOT_JOURNAL_TRANSMOG_BEGIN);
             bstmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_NPCBOT_TRANSMOG);
             //"DELETE FROM characters_npcbot_transmog WHERE entry = ?", CONNECTION_ASYNC
             bstmt->setUInt32(0, entry);
@@ -797,7 +1087,8 @@ void BotDataMgr::UpdateNpcBotData(uint32 entry, NpcBotDataUpdateType updateType,
             //"UPDATE character_npcbot SET roles = ? WHERE entry = ?", CONNECTION_ASYNC
             bstmt->setUInt32(0, itr->second->roles);
             bstmt->setUInt32(1, entry);
-            CharacterDatabase.Execute(bstmt);
+            if (!_journalStatement(entry, BOT_JOURNAL_ROLES, bstmt))
+                CharacterDatabase.Execute(bstmt);
             break;
         case NPCBOT_UPDATE_SPEC:
             itr->second->spec = *(uint8*)(data);
@@ -805,7 +1096,8 @@ void BotDataMgr::UpdateNpcBotData(uint32 entry, NpcBotDataUpdateType updateType,
             //"UPDATE characters_npcbot SET spec = ? WHERE entry = ?", CONNECTION_ASYNCH
             bstmt->setUInt8(0, itr->second->spec);
             bstmt->setUInt32(1, entry);
-            CharacterDatabase.Execute(bstmt);
+            if (!_journalStatement(entry, BOT_JOURNAL_SPEC, bstmt))
+                CharacterDatabase.Execute(bstmt);
             break;
         case NPCBOT_UPDATE_FACTION:
             itr->second->faction = *(uint32*)(data);
@@ -813,7 +1105,8 @@ void BotDataMgr::UpdateNpcBotData(uint32 entry, NpcBotDataUpdateType updateType,
             //"UPDATE characters_npcbot SET faction = ? WHERE entry = ?", CONNECTION_ASYNCH
             bstmt->setUInt32(0, itr->second->faction);
             bstmt->setUInt32(1, entry);
-            CharacterDatabase.Execute(bstmt);
+            if (!_journalStatement(entry, BOT_JOURNAL_FACTION, bstmt))
+                CharacterDatabase.Execute(bstmt);
             break;
         case NPCBOT_UPDATE_DISABLED_SPELLS:
         {
@@ -826,7 +1119,8 @@ void BotDataMgr::UpdateNpcBotData(uint32 entry, NpcBotDataUpdateType updateType,
             //"UPDATE characters_npcbot SET spells_disabled = ? WHERE entry = ?", CONNECTION_ASYNCH
             bstmt->setString(0, ss.str());
             bstmt->setUInt32(1, entry);
-            CharacterDatabase.Execute(bstmt);
+            if (!_journalStatement(entry, BOT_JOURNAL_DISABLED_SPELLS, bstmt))
+                CharacterDatabase.Execute(bstmt);
             break;
         }
         case NPCBOT_UPDATE_EQUIPS:
@@ -911,10 +1205,9 @@ void BotDataMgr::UpdateNpcBotData(uint32 entry, NpcBotDataUpdateType updateType,
         }
         case NPCBOT_UPDATE_ERASE:
         {
-            NpcBotDataMap::iterator bitr = _botsData.find(entry);
-            ASSERT(bitr != _botsData.end());
-            delete bitr->second;
-            _botsData.erase(bitr);
+            //freed with the last snapshot still referencing it
+            _botsData.Write(_botsData.GetShard(entry), [entry](NpcBotDataMap& dataMap) { dataMap.erase(entry); });
+            _journalDiscard(entry, BOT_JOURNAL_OWNER);
             bstmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_NPCBOT);
             //"DELETE FROM characters_npcbot WHERE entry = ?", CONNECTION_ASYNC
             bstmt->setUInt32(0, entry);
@@ -928,6 +1221,9 @@ void BotDataMgr::UpdateNpcBotData(uint32 entry, NpcBotDataUpdateType updateType,
 }
 void BotDataMgr::UpdateNpcBotDataAll(uint32 playerGuid, NpcBotDataUpdateType updateType, void* data)
 {
+    //statements below select bots by owner, pending changes must be applied first
+    FlushNpcBotDataJournal();
+
     CharacterDatabasePreparedStatement* bstmt;
     switch (updateType)
     {
@@ -992,7 +1288,56 @@ void BotDataMgr::SaveNpcBotStats(NpcBotStats const* stats)
     bstmt->setUInt32(++index, stats->expertise);
     bstmt->setFloat (++index, stats->armorPenPct);
 
-    CharacterDatabase.Execute(bstmt);
+    //npcbot: stats are write-only, do not delay player saves with them
+    CharacterDatabase.Execute(bstmt, SQL_PRIORITY_BACKGROUND);
+}
+
+void BotDataMgr::UpdateNpcBotDataJournal(uint32 diff)
+{
+    uint32 interval = BotMgr::GetDataJournalFlushInterval();
+    if (interval && _dataJournalFlushTimer + diff < interval)
+    {
+        _dataJournalFlushTimer += diff;
+        return;
+    }
+
+    _dataJournalFlushTimer = 0;
+    FlushNpcBotDataJournal();
+}
+
+void BotDataMgr::FlushNpcBotDataJournal(bool wait)
+{
+    NpcBotDataJournal journal;
+    {
+        std::lock_guard<std::mutex> lock(_dataJournalLock);
+        journal.swap(_dataJournal);
+    }
+
+    if (!journal.empty())
+    {
+        //queued behind immediate bot data statements instead of bypassing the queue
+        CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+        for (NpcBotDataJournal::value_type const& kv : journal)
+            trans->Append(kv.second);
+        CharacterDatabase.CommitTransaction(trans);
+
+        uint64 saved = GetNpcBotDataJournalStatementsSaved();
+        TC_LOG_DEBUG("npcbots", "BotDataMgr: saved %u pending bot data updates (" UI64FMTD " statements saved so far)", uint32(journal.size()), saved);
+        TC_METRIC_VALUE("npcbot_db_statements_saved", saved);
+    }
+
+    //async query only starts after all saves queued before it are finished, background writes (stats) are not waited for
+    if (wait)
+    {
+        QueryCallback barrier = CharacterDatabase.AsyncQuery("SELECT 1").WithCallback([](QueryResult /*result*/) {});
+        while (!barrier.InvokeIfReady())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+uint64 BotDataMgr::GetNpcBotDataJournalStatementsSaved()
+{
+    return _dataJournalStatementsSaved.load(std::memory_order_relaxed);
 }
 
 NpcBotAppearanceData const* BotDataMgr::SelectNpcBotAppearance(uint32 entry)
@@ -1030,7 +1375,8 @@ void BotDataMgr::UpdateNpcBotTransmogData(uint32 entry, uint8 slot, uint32 item_
         bstmt->setUInt8(1, slot);
         bstmt->setUInt32(2, item_id);
         bstmt->setUInt32(3, fake_id);
-        CharacterDatabase.Execute(bstmt);
+        if (!_journalStatement(entry, BOT_JOURNAL_TRANSMOG_BEGIN + slot, bstmt))
+            CharacterDatabase.Execute(bstmt);
     }
 }
 
@@ -1054,7 +1400,8 @@ void BotDataMgr::ResetNpcBotTransmogData(uint32 entry, bool update_db)
             bstmt->setUInt8(1, i);
             bstmt->setUInt32(2, 0);
             bstmt->setUInt32(3, 0);
-            trans->Append(bstmt);
+            if (!_journalStatement(entry, BOT_JOURNAL_TRANSMOG_BEGIN + i, bstmt))
+                trans->Append(bstmt);
         }
 
         if (trans->GetSize() > 0)
@@ -1067,40 +1414,28 @@ void BotDataMgr::ResetNpcBotTransmogData(uint32 entry, bool update_db)
 
 void BotDataMgr::RegisterBot(Creature const* bot)
 {
-    if (_existingBots.find(bot) != _existingBots.end())
-    {
-        TC_LOG_ERROR("entities.unit", "BotDataMgr::RegisterBot: bot %u (%s) already registered!",
-            bot->GetEntry(), bot->GetName().c_str());
-        return;
-    }
-
-    std::unique_lock<std::shared_mutex> lock(*GetLock());
-
-    _existingBots.insert(bot);
+    _existingBots.Write(_existingBots.GetShard(bot->GetEntry()), [bot](NpcBotRegistryShard& registry) {
+        if (!registry.emplace(bot, bot->GetGUID()).second)
+            TC_LOG_ERROR("entities.unit", "BotDataMgr::RegisterBot: bot %u (%s) already registered!",
+                bot->GetEntry(), bot->GetName().c_str());
+    });
     //TC_LOG_ERROR("entities.unit", "BotDataMgr::RegisterBot: registered bot %u (%s)", bot->GetEntry(), bot->GetName().c_str());
 }
 void BotDataMgr::UnregisterBot(Creature const* bot)
 {
-    if (_existingBots.find(bot) == _existingBots.end())
-    {
-        TC_LOG_ERROR("entities.unit", "BotDataMgr::UnregisterBot: bot %u (%s) not found!",
-            bot->GetEntry(), bot->GetName().c_str());
-        return;
-    }
-
-    std::unique_lock<std::shared_mutex> lock(*GetLock());
-
-    _existingBots.erase(bot);
+    _existingBots.Write(_existingBots.GetShard(bot->GetEntry()), [bot](NpcBotRegistryShard& registry) {
+        if (!registry.erase(bot))
+            TC_LOG_ERROR("entities.unit", "BotDataMgr::UnregisterBot: bot %u (%s) not found!",
+                bot->GetEntry(), bot->GetName().c_str());
+    });
     //TC_LOG_ERROR("entities.unit", "BotDataMgr::UnregisterBot: unregistered bot %u (%s)", bot->GetEntry(), bot->GetName().c_str());
 }
 Creature const* BotDataMgr::FindBot(uint32 entry)
 {
-    std::shared_lock<std::shared_mutex> lock(*GetLock());
-
-    for (NpcBotRegistry::const_iterator ci = _existingBots.cbegin(); ci != _existingBots.cend(); ++ci)
+    for (NpcBotRegistryShard::value_type const& bot_pair : *_existingBots.Read(_existingBots.GetShard(entry)))
     {
-        if ((*ci)->GetEntry() == entry)
-            return *ci;
+        if (bot_pair.second.GetEntry() == entry)
+            return bot_pair.first;
     }
     return nullptr;
 }
@@ -1110,44 +1445,53 @@ Creature const* BotDataMgr::FindBot(std::string_view name, LocaleConstant loc)
     if (Utf8toWStr(name, wname))
     {
         wstrToLower(wname);
-        std::shared_lock<std::shared_mutex> lock(*GetLock());
-        for (NpcBotRegistry::const_iterator ci = _existingBots.cbegin(); ci != _existingBots.cend(); ++ci)
+        for (uint32 i = 0; i != BotShardedSnapshot<NpcBotRegistryShard>::SHARDS; ++i)
         {
-            std::string basename = (*ci)->GetName();
-            if (CreatureLocale const* creatureInfo = sObjectMgr->GetCreatureLocale((*ci)->GetEntry()))
+            for (NpcBotRegistryShard::value_type const& bot_pair : *_existingBots.Read(i))
             {
-                if (creatureInfo->Name.size() > loc && !creatureInfo->Name[loc].empty())
-                    basename = creatureInfo->Name[loc];
-            }
+                Creature const* bot = bot_pair.first;
+                std::string basename = bot->GetName();
+                if (CreatureLocale const* creatureInfo = sObjectMgr->GetCreatureLocale(bot->GetEntry()))
+                {
+                    if (creatureInfo->Name.size() > loc && !creatureInfo->Name[loc].empty())
+                        basename = creatureInfo->Name[loc];
+                }
 
-            std::wstring wbname;
-            if (!Utf8toWStr(basename, wbname))
-                continue;
+                std::wstring wbname;
+                if (!Utf8toWStr(basename, wbname))
+                    continue;
 
-            wstrToLower(wbname);
-            if (wbname == wname)
-                return *ci;
+                wstrToLower(wbname);
+                if (wbname == wname)
+                    return bot;
+            }
         }
     }
 
     return nullptr;
 }
 
-NpcBotRegistry const& BotDataMgr::GetExistingNPCBots()
+NpcBotRegistry BotDataMgr::GetExistingNPCBots()
 {
-    return _existingBots;
+    NpcBotRegistry bots;
+    for (uint32 i = 0; i != BotShardedSnapshot<NpcBotRegistryShard>::SHARDS; ++i)
+        for (NpcBotRegistryShard::value_type const& bot_pair : *_existingBots.Read(i))
+            bots.insert(bot_pair.first);
+    return bots;
 }
 
 void BotDataMgr::GetNPCBotGuidsByOwner(std::vector<ObjectGuid> &guids_vec, ObjectGuid owner_guid)
 {
     ASSERT(AllBotsLoaded());
 
-    std::shared_lock<std::shared_mutex> lock(*GetLock());
-
-    for (NpcBotRegistry::const_iterator ci = _existingBots.cbegin(); ci != _existingBots.cend(); ++ci)
+    for (uint32 i = 0; i != BotShardedSnapshot<NpcBotRegistryShard>::SHARDS; ++i)
     {
-        if (_botsData[(*ci)->GetEntry()]->owner == owner_guid.GetCounter())
-            guids_vec.push_back((*ci)->GetGUID());
+        for (NpcBotRegistryShard::value_type const& bot_pair : *_existingBots.Read(i))
+        {
+            NpcBotDataPtr botData = SelectNpcBotData(bot_pair.second.GetEntry());
+            if (botData && botData->owner == owner_guid.GetCounter())
+                guids_vec.push_back(bot_pair.second);
+        }
     }
 }
 
@@ -1155,12 +1499,10 @@ ObjectGuid BotDataMgr::GetNPCBotGuid(uint32 entry)
 {
     ASSERT(AllBotsLoaded());
 
-    std::shared_lock<std::shared_mutex> lock(*GetLock());
-
-    for (NpcBotRegistry::const_iterator ci = _existingBots.cbegin(); ci != _existingBots.cend(); ++ci)
+    for (NpcBotRegistryShard::value_type const& bot_pair : *_existingBots.Read(_existingBots.GetShard(entry)))
     {
-        if ((*ci)->GetEntry() == entry)
-            return (*ci)->GetGUID();
+        if (bot_pair.second.GetEntry() == entry)
+            return bot_pair.second;
     }
 
     return ObjectGuid::Empty;
@@ -1171,9 +1513,9 @@ std::vector<uint32> BotDataMgr::GetExistingNPCBotIds()
     ASSERT(AllBotsLoaded());
 
     std::vector<uint32> existing_ids;
-    existing_ids.reserve(_botsData.size());
-    for (decltype(_botsData)::value_type const& bot_data_pair : _botsData)
-        existing_ids.push_back(bot_data_pair.first);
+    for (uint32 i = 0; i != BotShardedSnapshot<NpcBotDataMap>::SHARDS; ++i)
+        for (NpcBotDataMap::value_type const& bot_data_pair : *_botsData.Read(i))
+            existing_ids.push_back(bot_data_pair.first);
 
     return existing_ids;
 }
@@ -1181,9 +1523,10 @@ std::vector<uint32> BotDataMgr::GetExistingNPCBotIds()
 uint8 BotDataMgr::GetOwnedBotsCount(ObjectGuid owner_guid, uint32 class_mask)
 {
     uint8 count = 0;
-    for (decltype(_botsData)::value_type const& bdata : _botsData)
-        if (bdata.second->owner == owner_guid.GetCounter() && (!class_mask || !!(class_mask & (1u << (_botsExtras[bdata.first]->bclass - 1)))))
-            ++count;
+    for (uint32 i = 0; i != BotShardedSnapshot<NpcBotDataMap>::SHARDS; ++i)
+        for (NpcBotDataMap::value_type const& bdata : *_botsData.Read(i))
+            if (bdata.second->owner == owner_guid.GetCounter() && (!class_mask || !!(class_mask & (1u << (_botsExtras[bdata.first]->bclass - 1)))))
+                ++count;
 
     return count;
 }
@@ -1315,79 +1658,51 @@ std::pair<uint8, uint8> BotDataMgr::GetZoneLevels(uint32 zoneId)
 
 std::pair<uint32, Position const*> BotDataMgr::GetWanderMapNode(uint32 mapId, uint32 curNodeId, uint32 lastNodeId, uint8 lvl)
 {
-    decltype(WanderMap.Nodes)::const_iterator cit = WanderMap.Nodes.find(mapId);
-    if (cit != WanderMap.Nodes.cend())
+    BotTravelGraph::BotTravelMap const* wmap = WanderMap.GetMap(mapId);
+    if (!wmap)
+        return { 0, nullptr };
+
+    uint32 cur = wmap->GetIndex(curNodeId);
+    if (cur == BotTravelGraph::INVALID_INDEX)
+        return { 0, nullptr };
+
+    uint32 next;
+    if (wmap->GetConnectionsCount(cur) == 1)
+        next = wmap->Edges[wmap->EdgeOffsets[cur]];
+    else
     {
-        decltype(WanderMap.Nodes)::value_type::second_type::const_iterator ici = cit->second.find(curNodeId);
-        if (ici != cit->second.cend())
-        {
-            std::vector<decltype(WanderMap)::BotTravelNode const*> convec;
-            if (ici->second.connections.size() == 1)
-                convec.push_back(ici->second.connections.front());
-            else
-            {
-                uint8 minlevel = 255;
-                for (auto const* con : ici->second.connections)
-                {
-                    if (con->id != lastNodeId && lvl >= con->minlevel && lvl <= con->maxlevel + 3)
-                        convec.push_back(con);
-                    if (con->maxlevel < minlevel)
-                        minlevel = con->maxlevel;
-                }
-                if (convec.empty())
-                {
-                    for (auto const* con : ici->second.connections)
-                    {
-                        if (con->id != lastNodeId && con->maxlevel == minlevel)
-                            convec.push_back(con);
-                    }
-                }
-                if (convec.empty())
-                {
-                    for (auto const* con : ici->second.connections)
-                    {
-                        if (con->maxlevel == minlevel)
-                            convec.push_back(con);
-                    }
-                }
-                if (convec.empty())
-                {
-                    for (auto const* con : ici->second.connections)
-                    {
-                        if (con->id != lastNodeId)
-                            convec.push_back(con);
-                    }
-                }
-            }
-            ASSERT(!convec.empty());
-            auto* randomNode = (convec.size() == 1) ? convec.front() : Trinity::Containers::SelectRandomContainerElement(convec);
-            return std::make_pair(randomNode->id, static_cast<Position const*>(randomNode));
-        }
+        //suitable for level, then lowest level connections, going back only if nothing else is left
+        uint32 last = wmap->GetIndex(lastNodeId);
+        BotTravelGraph::ChoiceRange const& lowest = wmap->Ranges[wmap->LowestRanges[cur]];
+        next = wmap->SelectChoice(wmap->Ranges[wmap->LevelRanges[cur * BotTravelGraph::NODE_LEVELS + lvl]], last);
+        if (next == BotTravelGraph::INVALID_INDEX)
+            next = wmap->SelectChoice(lowest, last);
+        if (next == BotTravelGraph::INVALID_INDEX)
+            next = wmap->Choices[lowest.begin];
     }
 
-    return { 0, nullptr };
+    BotTravelGraph::BotTravelNode const& node = wmap->Nodes[next];
+    return { node.id, static_cast<Position const*>(&node) };
 }
 
 Position const* BotDataMgr::GetWanderMapNodePosition(uint32 mapId, uint32 nodeId)
 {
-    decltype(WanderMap.Nodes)::const_iterator cit = WanderMap.Nodes.find(mapId);
-    if (cit != WanderMap.Nodes.cend())
+    if (BotTravelGraph::BotTravelMap const* wmap = WanderMap.GetMap(mapId))
     {
-        decltype(WanderMap.Nodes)::value_type::second_type::const_iterator ici = cit->second.find(nodeId);
-        if (ici != cit->second.cend())
-            return static_cast<Position const*>(&ici->second);
+        uint32 index = wmap->GetIndex(nodeId);
+        if (index != BotTravelGraph::INVALID_INDEX)
+            return static_cast<Position const*>(&wmap->Nodes[index]);
     }
     return nullptr;
 }
 
 std::string BotDataMgr::GetWanderMapNodeName(uint32 mapId, uint32 nodeId)
 {
-    decltype(WanderMap.Nodes)::const_iterator cit = WanderMap.Nodes.find(mapId);
-    if (cit != WanderMap.Nodes.cend())
+    if (BotTravelGraph::BotTravelMap const* wmap = WanderMap.GetMap(mapId))
     {
-        decltype(WanderMap.Nodes)::value_type::second_type::const_iterator ici = cit->second.find(nodeId);
-        if (ici != cit->second.cend())
-            return ici->second.name;
+        uint32 index = wmap->GetIndex(nodeId);
+        if (index != BotTravelGraph::INVALID_INDEX)
+            return wmap->Nodes[index].name;
     }
     return {};
 }
@@ -3,8 +3,8 @@
 
 #include "botcommon.h"
 
+#include <memory>
 #include <set>
-#include <shared_mutex>
 #include <vector>
 
 class Creature;
@@ -125,6 +125,7 @@ public:
 };
 
 typedef std::set<Creature const*> NpcBotRegistry;
+typedef std::shared_ptr<NpcBotData const> NpcBotDataPtr;
 
 class BotDataMgr
 {
@@ -133,10 +134,13 @@ class BotDataMgr
         static void LoadNpcBotGroupData();
 
         static void AddNpcBotData(uint32 entry, uint32 roles, uint8 spec, uint32 faction);
-        static NpcBotData const* SelectNpcBotData(uint32 entry);
+        static NpcBotDataPtr SelectNpcBotData(uint32 entry);
         static void UpdateNpcBotData(uint32 entry, NpcBotDataUpdateType updateType, void* data = nullptr);
         static void UpdateNpcBotDataAll(uint32 playerGuid, NpcBotDataUpdateType updateType, void* data = nullptr);
         static void SaveNpcBotStats(NpcBotStats const* stats);
+        static void UpdateNpcBotDataJournal(uint32 diff);
+        static void FlushNpcBotDataJournal(bool wait = false);
+        static uint64 GetNpcBotDataJournalStatementsSaved();
 
         static NpcBotAppearanceData const* SelectNpcBotAppearance(uint32 entry);
         static NpcBotExtras const* SelectNpcBotExtras(uint32 entry);
@@ -149,9 +153,11 @@ class BotDataMgr
 
         static void RegisterBot(Creature const* bot);
         static void UnregisterBot(Creature const* bot);
+        //bots are looked up without locking, returned creatures may only be used by world thread (commands, gossip)
+        //or by the map thread the bot is on, other threads can see bots that are being removed
         static Creature const* FindBot(uint32 entry);
         static Creature const* FindBot(std::string_view name, LocaleConstant loc);
-        static NpcBotRegistry const& GetExistingNPCBots();
+        static NpcBotRegistry GetExistingNPCBots();
         static void GetNPCBotGuidsByOwner(std::vector<ObjectGuid> &guids_vec, ObjectGuid owner_guid);
         static ObjectGuid GetNPCBotGuid(uint32 entry);
         static std::vector<uint32> GetExistingNPCBotIds();
@@ -169,8 +175,6 @@ class BotDataMgr
         static Position const* GetWanderMapNodePosition(uint32 mapId, uint32 nodeId);
         static std::string GetWanderMapNodeName(uint32 mapId, uint32 nodeId);
 
-        static std::shared_mutex* GetLock();
-
     private:
         BotDataMgr() {}
         BotDataMgr(BotDataMgr const&);
@@ -1,9 +1,7 @@
 #ifndef _BOT_DPSTRACKER_H
 #define _BOT_DPSTRACKER_H
 
-#include "Define.h"
-
-#include <unordered_map>
+#include "RollingWindowTable.h"
 
 class Unit;
 
@@ -11,7 +9,6 @@ class DPSTracker
 {
     public:
         DPSTracker();
-        ~DPSTracker();
 
         void Update(uint32 diff);
 
@@ -20,16 +17,16 @@ class DPSTracker
 
         void SetOwner(uint32 guidlow) { _ownerGuid = guidlow; }
 
+        //maximum tracked damage taken periods of DPS_UPDATE_TIMER during MAX_DPS_TRACK_TIME (see botdpstracker.cpp)
+        static constexpr uint32 MAX_DAMAGES = 10;
+        //party members, their bots and pets, bots of owner
+        static constexpr uint32 MAX_TRACKED_VICTIMS = 128;
+
     private:
         void _Reset();
-        void _Release();
-        void _AccumulateDamage(uint64 guid, uint32 damage);
         void _SetActive();
 
-        typedef std::unordered_map<uint64 /*guid*/, uint32* /*dmgarray*/> DamageTakenMap;
-        typedef std::unordered_map<uint64 /*guid*/, uint32 /*dps*/> DPSTakenMap;
-        DamageTakenMap _damages;
-        DPSTakenMap _DPSes;
+        RollingWindowTable<MAX_TRACKED_VICTIMS, MAX_DAMAGES> _damages;
 
         uint32 _ownerGuid;
 
@@ -747,6 +747,9 @@ bool NPCBotsDump::GetDump(std::string& dump)
     if (!integrityChecked || valid_ids.empty())
         return false;
 
+    //transmogs and equips are read from DB, pending and queued changes must be saved first
+    BotDataMgr::FlushNpcBotDataJournal(true);
+
     for (std::set<uint32>::const_iterator ci = valid_ids.begin(); ci != valid_ids.end(); ++ci)
     {
         AppendBotNPCBotData(&trans, *ci);
@@ -762,7 +765,7 @@ bool NPCBotsDump::GetDump(std::string& dump)
 
 BotDataVerificationResult NPCBotsDump::VerifyWriteData(uint32 entry) const
 {
-    NpcBotData const* botData = BotDataMgr::SelectNpcBotData(entry);
+    NpcBotDataPtr botData = BotDataMgr::SelectNpcBotData(entry);
 
     //bot of this entry is not spawned
     if (!botData)
@@ -815,7 +818,7 @@ std::string const EscapedString(char const* cstr)
 
 void NPCBotsDump::AppendBotNPCBotData(BotStringTransaction* trans, uint32 entry) const
 {
-    NpcBotData const* botData = BotDataMgr::SelectNpcBotData(entry);
+    NpcBotDataPtr botData = BotDataMgr::SelectNpcBotData(entry);
     ASSERT(botData);
 
     std::ostringstream ss;
@@ -850,7 +853,7 @@ void NPCBotsDump::AppendBotNPCBotData(BotStringTransaction* trans, uint32 entry)
 
 void NPCBotsDump::AppendBotNPCBotTransmogData(BotStringTransaction* trans, uint32 entry) const
 {
-    NpcBotData const* botData = BotDataMgr::SelectNpcBotData(entry);
+    NpcBotDataPtr botData = BotDataMgr::SelectNpcBotData(entry);
     ASSERT(botData);
 
     QueryResult tresult = CharacterDatabase.PQuery("SELECT `entry`,`slot`,`item_id`,`fake_id` FROM `characters_npcbot_transmog` WHERE entry = %u", entry);
@@ -898,7 +901,7 @@ void NPCBotsDump::AppendBotNPCBotTransmogData(BotStringTransaction* trans, uint3
 
 void NPCBotsDump::AppendBotEquipsData(BotStringTransaction* trans, uint32 entry) const
 {
-    NpcBotData const* botData = BotDataMgr::SelectNpcBotData(entry);
+    NpcBotDataPtr botData = BotDataMgr::SelectNpcBotData(entry);
     ASSERT(botData);
 
     EquipmentInfo const* deinfo = BotDataMgr::GetBotEquipmentInfo(entry);
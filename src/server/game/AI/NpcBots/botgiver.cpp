@@ -86,18 +86,15 @@ public:
                     uint8 availCount = 0;
                     std::array<uint32, BOT_CLASS_END> npcbot_count_per_class{ 0 };
 
+                    for (Creature const* bot : BotDataMgr::GetExistingNPCBots())
                     {
-                        std::unique_lock<std::shared_mutex> lock(*BotDataMgr::GetLock());
-                        for (Creature const* bot : BotDataMgr::GetExistingNPCBots())
-                        {
-                            if (!bot->IsAlive() || bot->IsTempBot() || bot->IsWandererBot() || bot->GetBotAI()->GetBotOwnerGuid() || bot->HasAura(BERSERK))
-                                continue;
-                            if (BotMgr::FilterRaces() && bot->GetBotClass() < BOT_CLASS_EX_START && (bot->GetRaceMask() & RACEMASK_ALL_PLAYABLE) &&
-                                !(bot->GetRaceMask() & ((player->GetRaceMask() & RACEMASK_ALLIANCE) ? RACEMASK_ALLIANCE : RACEMASK_HORDE)))
-                                continue;
+                        if (!bot->IsAlive() || bot->IsTempBot() || bot->IsWandererBot() || bot->GetBotAI()->GetBotOwnerGuid() || bot->HasAura(BERSERK))
+                            continue;
+                        if (BotMgr::FilterRaces() && bot->GetBotClass() < BOT_CLASS_EX_START && (bot->GetRaceMask() & RACEMASK_ALL_PLAYABLE) &&
+                            !(bot->GetRaceMask() & ((player->GetRaceMask() & RACEMASK_ALLIANCE) ? RACEMASK_ALLIANCE : RACEMASK_HORDE)))
+                            continue;
 
-                            ++npcbot_count_per_class[bot->GetBotClass()];
-                        }
+                        ++npcbot_count_per_class[bot->GetBotClass()];
                     }
 
                     for (uint8 botclass = BOT_CLASS_WARRIOR; botclass < BOT_CLASS_END; ++botclass)
@@ -177,8 +174,7 @@ public:
                     uint8 availCount = 0;
 
                     //go through bots map to find what bots are available
-                    std::unique_lock<std::shared_mutex> lock(*BotDataMgr::GetLock());
-                    NpcBotRegistry const& allBots = BotDataMgr::GetExistingNPCBots();
+                    NpcBotRegistry const allBots = BotDataMgr::GetExistingNPCBots();
                     for (NpcBotRegistry::const_iterator ci = allBots.begin(); ci != allBots.end(); ++ci)
                     {
                         Creature const* bot = *ci;
@@ -27,6 +27,9 @@
 #include "SpellAuraEffects.h"
 #include "Transport.h"
 #include "World.h"
+
+#include <atomic>
+
 /*
 Npc Bot Manager by Trickerer (onlysuffering@gmail.com)
 Player NpcBots management
@@ -55,6 +58,10 @@ uint32 _npcBotEngageDelayDPS_default;
 uint32 _npcBotEngageDelayHeal_default;
 uint32 _npcBotOwnerExpireTime;
 uint32 _desiredWanderingBotsCount;
+uint32 _updateLODIntervals[BOT_UPDATE_TIER_END];
+float _updateLODNearDistance;
+bool _updateLODEnable;
+uint32 _dataJournalFlushInterval;
 bool _enableNpcBots;
 bool _enableNpcBotsDungeons;
 bool _enableNpcBotsRaids;
@@ -114,6 +121,8 @@ float _mult_dmg_seawitch;
 
 bool __firstload = true;
 
+std::atomic<uint32> _botsCountByUpdateTier[BOT_UPDATE_TIER_END] = {};
+
 void AddSC_death_knight_bot();
 void AddSC_druid_bot();
 void AddSC_hunter_bot();
@@ -273,6 +282,13 @@ void BotMgr::LoadConfig(bool reload)
     _npcBotEngageDelayHeal_default  = sConfigMgr->GetIntDefault("NpcBot.EngageDelay.Heal", 0);
     _npcBotOwnerExpireTime          = sConfigMgr->GetIntDefault("NpcBot.OwnershipExpireTime", 0);
     _desiredWanderingBotsCount      = sConfigMgr->GetIntDefault("NpcBot.DesiredWanderingBotsCount", 0);
+    _updateLODEnable                = sConfigMgr->GetBoolDefault("NpcBot.UpdateLOD.Enable", false);
+    _updateLODNearDistance          = sConfigMgr->GetFloatDefault("NpcBot.UpdateLOD.NearDistance", 100.0f);
+    _updateLODIntervals[BOT_UPDATE_TIER_COMBAT]  = 0;
+    _updateLODIntervals[BOT_UPDATE_TIER_NEAR]    = sConfigMgr->GetIntDefault("NpcBot.UpdateLOD.Interval.Near", 0);
+    _updateLODIntervals[BOT_UPDATE_TIER_FAR]     = sConfigMgr->GetIntDefault("NpcBot.UpdateLOD.Interval.Far", 1000);
+    _updateLODIntervals[BOT_UPDATE_TIER_DORMANT] = sConfigMgr->GetIntDefault("NpcBot.UpdateLOD.Interval.Dormant", 5000);
+    _dataJournalFlushInterval       = sConfigMgr->GetIntDefault("NpcBot.Database.FlushInterval", 0);
     _botPvP                         = sConfigMgr->GetBoolDefault("NpcBot.PvP", true);
     _botMovementFoodInterrupt       = sConfigMgr->GetBoolDefault("NpcBot.Movements.InterruptFood", false);
     _displayEquipment               = sConfigMgr->GetBoolDefault("NpcBot.EquipmentDisplay.Enable", true);
@@ -521,6 +537,34 @@ uint32 BotMgr::GetDesiredWanderingBotsCount()
 {
     return _desiredWanderingBotsCount;
 }
+bool BotMgr::IsUpdateLODEnabled()
+{
+    return _updateLODEnable;
+}
+float BotMgr::GetUpdateLODNearDistance()
+{
+    return _updateLODNearDistance;
+}
+uint32 BotMgr::GetUpdateLODInterval(uint8 tier)
+{
+    return tier < BOT_UPDATE_TIER_END ? _updateLODIntervals[tier] : 0;
+}
+uint32 BotMgr::GetDataJournalFlushInterval()
+{
+    return _dataJournalFlushInterval;
+}
+uint32 BotMgr::GetBotsCountByUpdateTier(uint8 tier)
+{
+    return tier < BOT_UPDATE_TIER_END ? _botsCountByUpdateTier[tier].load(std::memory_order_relaxed) : 0;
+}
+void BotMgr::OnBotUpdateTierChanged(uint8 oldTier, uint8 newTier)
+{
+    //bots are updated from map threads
+    if (oldTier < BOT_UPDATE_TIER_END)
+        _botsCountByUpdateTier[oldTier].fetch_sub(1, std::memory_order_relaxed);
+    if (newTier < BOT_UPDATE_TIER_END)
+        _botsCountByUpdateTier[newTier].fetch_add(1, std::memory_order_relaxed);
+}
 float BotMgr::GetBotStatLimitDodge()
 {
     return _botStatLimits_dodge;
@@ -95,6 +95,12 @@ class TC_GAME_API BotMgr
         static uint32 GetBaseUpdateDelay();
         static uint32 GetOwnershipExpireTime();
         static uint32 GetDesiredWanderingBotsCount();
+        static bool IsUpdateLODEnabled();
+        static float GetUpdateLODNearDistance();
+        static uint32 GetUpdateLODInterval(uint8 tier);
+        static uint32 GetDataJournalFlushInterval();
+        static uint32 GetBotsCountByUpdateTier(uint8 tier);
+        static void OnBotUpdateTierChanged(uint8 oldTier, uint8 newTier);
         static float GetBotStatLimitDodge();
         static float GetBotStatLimitParry();
         static float GetBotStatLimitBlock();
@@ -0,0 +1,144 @@
+#include "botperception.h"
+#include "Creature.h"
+#include "Map.h"
+#include "Player.h"
+#include "TypeContainerVisitor.h"
+
+/*
+Name: bot_perception
+%Complete: 100
+Comment: shared grid search results for NPCBot system
+*/
+
+enum BotPerceptionConstants : uint32
+{
+    //cells gathered around standing cell in each direction, any area larger than 5x5 cells is visited directly
+    //(Cell::Visit() switches to VisitCircle() above that anyway)
+    PERCEPTION_CELL_RANGE   = 2,
+    PERCEPTION_CELLS        = (PERCEPTION_CELL_RANGE * 2 + 1) * (PERCEPTION_CELL_RANGE * 2 + 1)
+};
+
+struct BotPerceptionGatherer
+{
+    BotPerceptionCache::CandidateVec& i_candidates;
+
+    BotPerceptionGatherer(BotPerceptionCache::CandidateVec& candidates) : i_candidates(candidates) { }
+
+    void Visit(CreatureMapType& m)
+    {
+        for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+            i_candidates.push_back({ itr->GetSource() });
+    }
+    void Visit(PlayerMapType& m)
+    {
+        for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+            i_candidates.push_back({ itr->GetSource() });
+    }
+
+    template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) { }
+};
+
+BotPerceptionCache::BotPerceptionCache(Map* map) : _map(map), _cellVisitsRequested(0), _cellVisitsDone(0), _open(false)
+{
+}
+
+void BotPerceptionCache::Open()
+{
+    _cellVisitsRequested = 0;
+    _cellVisitsDone = 0;
+    _open = true;
+}
+
+void BotPerceptionCache::Close()
+{
+    _open = false;
+    _candidates.clear();
+}
+
+BotPerceptionCache::CandidateVec const* BotPerceptionCache::GetCandidates(WorldObject const* center, float radius, CellArea& area)
+{
+    if (!_open || center->GetMap() != _map)
+        return nullptr;
+
+    CellCoord standing = Trinity::ComputeCellCoord(center->GetPositionX(), center->GetPositionY());
+    if (!standing.IsCoordValid())
+        return nullptr;
+
+    //same area as Cell::Visit() would search
+    radius += center->GetCombatReach();
+    if (radius > 0.0f)
+        area = Cell::CalculateCellArea(center->GetPositionX(), center->GetPositionY(), std::min<float>(radius, SIZE_OF_GRIDS));
+    else
+        area = CellArea(standing, standing);
+
+    if (area.low_bound.x_coord + PERCEPTION_CELL_RANGE < standing.x_coord || area.high_bound.x_coord > standing.x_coord + PERCEPTION_CELL_RANGE ||
+        area.low_bound.y_coord + PERCEPTION_CELL_RANGE < standing.y_coord || area.high_bound.y_coord > standing.y_coord + PERCEPTION_CELL_RANGE)
+        return nullptr;
+
+    _cellVisitsRequested += (area.high_bound.x_coord - area.low_bound.x_coord + 1) * (area.high_bound.y_coord - area.low_bound.y_coord + 1);
+
+    std::pair<CandidatesMap::iterator, bool> inserted = _candidates.try_emplace(standing.GetId());
+    if (inserted.second)
+        _Gather(standing, inserted.first->second);
+
+    return &inserted.first->second;
+}
+
+void BotPerceptionCache::Invalidate(CellCoord const& cell)
+{
+    if (!_open || _candidates.empty())
+        return;
+
+    uint32 const x_begin = cell.x_coord > PERCEPTION_CELL_RANGE ? cell.x_coord - PERCEPTION_CELL_RANGE : 0;
+    uint32 const y_begin = cell.y_coord > PERCEPTION_CELL_RANGE ? cell.y_coord - PERCEPTION_CELL_RANGE : 0;
+    uint32 const x_end = std::min<uint32>(cell.x_coord + PERCEPTION_CELL_RANGE, TOTAL_NUMBER_OF_CELLS_PER_MAP - 1);
+    uint32 const y_end = std::min<uint32>(cell.y_coord + PERCEPTION_CELL_RANGE, TOTAL_NUMBER_OF_CELLS_PER_MAP - 1);
+
+    for (uint32 x = x_begin; x <= x_end; ++x)
+        for (uint32 y = y_begin; y <= y_end; ++y)
+            _candidates.erase(CellCoord(x, y).GetId());
+}
+
+uint32 BotPerceptionCache::GetCellVisitsSaved() const
+{
+    return _cellVisitsRequested > _cellVisitsDone ? _cellVisitsRequested - _cellVisitsDone : 0;
+}
+
+void BotPerceptionCache::_Gather(CellCoord const& center, CandidateVec& candidates)
+{
+    //same order as Cell::VisitAllObjects(): world objects (players, pets) first, then grid objects
+    BotPerceptionGatherer gatherer(candidates);
+    TypeContainerVisitor<BotPerceptionGatherer, WorldTypeMapContainer> world_gatherer(gatherer);
+    TypeContainerVisitor<BotPerceptionGatherer, GridTypeMapContainer> grid_gatherer(gatherer);
+    _GatherCells(center, world_gatherer);
+    _GatherCells(center, grid_gatherer);
+
+    _cellVisitsDone += PERCEPTION_CELLS;
+}
+
+template<class Visitor>
+void BotPerceptionCache::_GatherCells(CellCoord const& center, Visitor& visitor)
+{
+    //standing cell first, then the rest row by row like Cell::Visit()
+    Cell standing(center);
+    standing.SetNoCreate();
+    _map->Visit(standing, visitor);
+
+    uint32 const x_begin = center.x_coord > PERCEPTION_CELL_RANGE ? center.x_coord - PERCEPTION_CELL_RANGE : 0;
+    uint32 const y_begin = center.y_coord > PERCEPTION_CELL_RANGE ? center.y_coord - PERCEPTION_CELL_RANGE : 0;
+    uint32 const x_end = std::min<uint32>(center.x_coord + PERCEPTION_CELL_RANGE, TOTAL_NUMBER_OF_CELLS_PER_MAP - 1);
+    uint32 const y_end = std::min<uint32>(center.y_coord + PERCEPTION_CELL_RANGE, TOTAL_NUMBER_OF_CELLS_PER_MAP - 1);
+
+    for (uint32 x = x_begin; x <= x_end; ++x)
+    {
+        for (uint32 y = y_begin; y <= y_end; ++y)
+        {
+            if (x == center.x_coord && y == center.y_coord)
+                continue;
+
+            Cell cell(CellCoord(x, y));
+            cell.SetNoCreate();
+            _map->Visit(cell, visitor);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef _BOT_PERCEPTION_H
+#define _BOT_PERCEPTION_H
+
+#include "Cell.h"
+
+#include <unordered_map>
+#include <vector>
+
+class Map;
+class Unit;
+class WorldObject;
+
+/*
+Per-map bot perception cache. Units in a neighborhood of cells are gathered once per map update
+and shared by all bots querying around the same cell instead of each bot walking the grid again.
+Only valid during map objects update, units are not deleted until remove list is processed.
+Neighborhoods are dropped when a unit enters one of their cells, units that left the map or
+moved away are filtered out by the reader (see VisitNearbyUnitsCached).
+Units are kept in the order Cell::VisitAllObjects() finds them, so results keep the order of direct grid searches.
+Used by map update thread only
+*/
+class BotPerceptionCache
+{
+    public:
+        struct Candidate
+        {
+            Unit* unit;
+        };
+        typedef std::vector<Candidate> CandidateVec;
+
+        explicit BotPerceptionCache(Map* map);
+
+        void Open();
+        void Close();
+
+        //returns nullptr if cache cannot serve the area searched around center object
+        CandidateVec const* GetCandidates(WorldObject const* center, float radius, CellArea& area);
+
+        //a unit was added to the grid at cell, drops every gathered neighborhood containing it
+        void Invalidate(CellCoord const& cell);
+
+        //cells bots would visit searching around minus cells actually visited, since last Open()
+        uint32 GetCellVisitsSaved() const;
+
+        static bool IsInArea(CellArea const& area, CellCoord const& cell)
+        {
+            return cell.x_coord >= area.low_bound.x_coord && cell.x_coord <= area.high_bound.x_coord &&
+                cell.y_coord >= area.low_bound.y_coord && cell.y_coord <= area.high_bound.y_coord;
+        }
+
+    private:
+        void _Gather(CellCoord const& center, CandidateVec& candidates);
+        template<class Visitor>
+        void _GatherCells(CellCoord const& center, Visitor& visitor);
+
+        typedef std::unordered_map<uint32 /*cellId*/, CandidateVec> CandidatesMap;
+        CandidatesMap _candidates;
+        Map* _map;
+        uint32 _cellVisitsRequested;
+        uint32 _cellVisitsDone;
+        bool _open;
+
+        BotPerceptionCache(BotPerceptionCache const&) = delete;
+        BotPerceptionCache& operator=(BotPerceptionCache const&) = delete;
+};
+
+#endif
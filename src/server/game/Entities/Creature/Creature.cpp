@@ -871,12 +871,19 @@ void Creature::Update(uint32 diff)
                 }
             }
 
+            //npcbot: AI level of detail
             if (bot_AI)
             {
                 //TC_LOG_ERROR("entities.unit", "creature update for %u", m_spawnId);
+                uint32 aiDiff;
+                if (bot_AI->CanUpdateAI(diff, aiDiff))
+                    Unit::AIUpdateTick(aiDiff);
             }
-
-            Unit::AIUpdateTick(diff);
+            else
+            {
+                Unit::AIUpdateTick(diff);
+            }
+            //end npcbot
 
             //npcbot: skip regeneration
             if (bot_AI || bot_pet_AI)
@@ -72,6 +72,7 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
 
         void AddToWorld() override;
         void RemoveFromWorld() override;
+        void UpdateGridPosition() override { UpdatePositionInGrid(GetPositionX(), GetPositionY(), GetCombatReach()); }
 
         float GetNativeObjectScale() const override;
         void SetObjectScale(float scale) override;
@@ -13,8 +13,20 @@ class GridObject
         bool IsInGrid() const { return _gridRef.isValid(); }
         void AddToGrid(GridRefManager<T>& m) { ASSERT(!IsInGrid()); _gridRef.link(&m, (T*)this); }
         void RemoveFromGrid() { ASSERT(IsInGrid()); _gridRef.unlink(); }
+
+        // slot in the position index of the cell, assigned when the index is built
+        void SetGridPositionSlot(uint32 slot) { _gridPositionSlot = slot; }
+
+    protected:
+        void UpdatePositionInGrid(float x, float y, float reach)
+        {
+            if (IsInGrid())
+                _gridRef.getTarget()->UpdatePosition(_gridPositionSlot, x, y, reach);
+        }
+
     private:
         GridReference<T> _gridRef;
+        uint32 _gridPositionSlot = 0;
 };
 
 #endif
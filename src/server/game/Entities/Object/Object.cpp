@@ -74,6 +74,7 @@ Object::Object() : m_PackGUID(sizeof(uint64)+1)
     m_uint32Values      = nullptr;
     m_valuesCount       = 0;
     _fieldNotifyFlags   = UF_FLAG_DYNAMIC;
+    m_valuesVersion     = 0;
 
     m_inWorld           = false;
     m_isNewObject       = false;
@@ -482,25 +483,112 @@ void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player const*
     if (!target)
         return;
 
-    ByteBuffer fieldBuffer;
-    UpdateMaskPacketBuilder updateMask(m_valuesCount);
-
     uint32* flags = nullptr;
     uint32 visibleFlag = GetUpdateFieldData(target, flags);
     ASSERT(flags);
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    BuildSharedValuesUpdate(updateType, data, target, visibleFlag, flags);
+}
+
+// Values blocks of recently updated objects, kept per thread
+// A new values version is assigned after each change so stale blocks of an object, or of an object deleted
+// and allocated again at the same address, never match
+struct SharedValuesBlock
+{
+    SharedValuesBlock(uint8 updateType, uint32 visibleFlag, std::size_t size) : UpdateType(updateType), VisibleFlag(visibleFlag), Data(size) { }
+
+    uint8 UpdateType;
+    uint32 VisibleFlag;
+    ByteBuffer Data;                                        // update mask followed by field values
+    std::vector<std::pair<uint16, uint32>> TargetFields;    // index and offset in Data of per target fields
+};
+
+struct SharedValuesBlocks
+{
+    uint64 Version = 0;
+    std::vector<SharedValuesBlock> Blocks;
+};
+
+static constexpr std::size_t MAX_SHARED_VALUES_OBJECTS = 1024;
+static thread_local std::unordered_map<Object const*, SharedValuesBlocks> sharedValuesBlocks;
+static std::atomic<uint64> valuesVersionCounter(0);
+
+uint64 Object::GetValuesVersion() const
+{
+    uint64 version = m_valuesVersion.load(std::memory_order_relaxed);
+    if (!version)
+    {
+        uint64 newVersion = ++valuesVersionCounter;
+        if (m_valuesVersion.compare_exchange_strong(version, newVersion, std::memory_order_relaxed))
+            version = newVersion;
+    }
+
+    return version;
+}
+
+bool Object::IsUpdateFieldSent(uint8 updateType, uint16 index, uint32 fieldFlags, uint32 visibleFlag) const
+{
+    return (_fieldNotifyFlags & fieldFlags) ||
+        ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (fieldFlags & visibleFlag));
+}
+
+void Object::BuildSharedValuesUpdate(uint8 updateType, ByteBuffer* data, Player const* target, uint32 visibleFlag, uint32 const* flags) const
+{
+    uint64 version = GetValuesVersion();
+
+    if (sharedValuesBlocks.size() >= MAX_SHARED_VALUES_OBJECTS && sharedValuesBlocks.find(this) == sharedValuesBlocks.end())
+        sharedValuesBlocks.clear();
+
+    SharedValuesBlocks& blocks = sharedValuesBlocks[this];
+    if (blocks.Version != version)
+    {
+        blocks.Version = version;
+        blocks.Blocks.clear();
+    }
+
+    auto itr = std::find_if(blocks.Blocks.begin(), blocks.Blocks.end(), [updateType, visibleFlag](SharedValuesBlock const& block)
     {
-        if (_fieldNotifyFlags & flags[index] ||
-            ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)))
+        return block.UpdateType == updateType && block.VisibleFlag == visibleFlag;
+    });
+
+    if (itr == blocks.Blocks.end())
+    {
+        ByteBuffer fieldBuffer;
+        UpdateMaskPacketBuilder updateMask(m_valuesCount);
+        std::vector<std::pair<uint16, uint32>> targetFields;
+
+        for (uint16 index = 0; index < m_valuesCount; ++index)
         {
-            updateMask.SetBit(index);
-            fieldBuffer << m_uint32Values[index];
+            if (IsUpdateFieldSent(updateType, index, flags[index], visibleFlag))
+            {
+                updateMask.SetBit(index);
+
+                if (IsUpdateFieldPerTarget(index))
+                {
+                    targetFields.emplace_back(index, uint32(fieldBuffer.wpos()));
+                    fieldBuffer << uint32(0);
+                }
+                else
+                    fieldBuffer << GetUpdateFieldValue(index);
+            }
         }
+
+        SharedValuesBlock block(updateType, visibleFlag, 1 + (m_valuesCount + 31) / 32 * 4 + fieldBuffer.wpos());
+        updateMask.AppendToPacket(&block.Data);
+
+        uint32 fieldsOffset = uint32(block.Data.wpos());
+        for (std::pair<uint16, uint32>& field : targetFields)
+            field.second += fieldsOffset;
+
+        block.Data.append(fieldBuffer);
+        block.TargetFields = std::move(targetFields);
+        itr = blocks.Blocks.insert(blocks.Blocks.end(), std::move(block));
     }
 
-    updateMask.AppendToPacket(data);
-    data->append(fieldBuffer);
+    std::size_t start = data->wpos();
+    data->append(itr->Data);
+    for (std::pair<uint16, uint32> const& field : itr->TargetFields)
+        data->put<uint32>(start + field.second, GetUpdateFieldValueForTarget(field.first, target));
 }
 
 void Object::AddToObjectUpdateIfNeeded()
@@ -512,6 +600,7 @@ void Object::AddToObjectUpdateIfNeeded()
 void Object::ClearUpdateMask(bool remove)
 {
     _changesMask.Clear();
+    MarkValuesChanged();
 
     if (m_objectUpdated)
     {
@@ -606,6 +695,7 @@ bool Object::_LoadIntoDataField(std::string const& data, uint32 startOffset, uin
             return false;
         m_uint32Values[startOffset + index] = *val;
         _changesMask.SetBit(startOffset + index);
+        MarkValuesChanged();
     }
     return true;
 }
@@ -618,6 +708,7 @@ void Object::SetInt32Value(uint16 index, int32 value)
     {
         m_int32Values[index] = value;
         _changesMask.SetBit(index);
+        MarkValuesChanged();
 
         AddToObjectUpdateIfNeeded();
     }
@@ -631,6 +722,7 @@ void Object::SetUInt32Value(uint16 index, uint32 value)
     {
         m_uint32Values[index] = value;
         _changesMask.SetBit(index);
+        MarkValuesChanged();
 
         AddToObjectUpdateIfNeeded();
     }
@@ -642,6 +734,7 @@ void Object::UpdateUInt32Value(uint16 index, uint32 value)
 
     m_uint32Values[index] = value;
     _changesMask.SetBit(index);
+    MarkValuesChanged();
 }
 
 void Object::SetUInt64Value(uint16 index, uint64 value)
@@ -653,6 +746,7 @@ void Object::SetUInt64Value(uint16 index, uint64 value)
         m_uint32Values[index + 1] = PAIR64_HIPART(value);
         _changesMask.SetBit(index);
         _changesMask.SetBit(index + 1);
+        MarkValuesChanged();
 
         AddToObjectUpdateIfNeeded();
     }
@@ -666,6 +760,7 @@ bool Object::AddGuidValue(uint16 index, ObjectGuid value)
         *((ObjectGuid*)&(m_uint32Values[index])) = value;
         _changesMask.SetBit(index);
         _changesMask.SetBit(index + 1);
+        MarkValuesChanged();
 
         AddToObjectUpdateIfNeeded();
 
@@ -684,6 +779,7 @@ bool Object::RemoveGuidValue(uint16 index, ObjectGuid value)
         m_uint32Values[index + 1] = 0;
         _changesMask.SetBit(index);
         _changesMask.SetBit(index + 1);
+        MarkValuesChanged();
 
         AddToObjectUpdateIfNeeded();
 
@@ -701,6 +797,7 @@ void Object::SetFloatValue(uint16 index, float value)
     {
         m_floatValues[index] = value;
         _changesMask.SetBit(index);
+        MarkValuesChanged();
 
         AddToObjectUpdateIfNeeded();
     }
@@ -716,6 +813,7 @@ void Object::SetByteValue(uint16 index, uint8 offset, uint8 value)
         m_uint32Values[index] &= ~uint32(uint32(0xFF) << (offset * 8));
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 8));
         _changesMask.SetBit(index);
+        MarkValuesChanged();
 
         AddToObjectUpdateIfNeeded();
 
@@ -732,6 +830,7 @@ void Object::SetUInt16Value(uint16 index, uint8 offset, uint16 value)
         m_uint32Values[index] &= ~uint32(uint32(0xFFFF) << (offset * 16));
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 16));
         _changesMask.SetBit(index);
+        MarkValuesChanged();
 
         AddToObjectUpdateIfNeeded();
     }
@@ -745,6 +844,7 @@ void Object::SetGuidValue(uint16 index, ObjectGuid value)
         *((ObjectGuid*)&(m_uint32Values[index])) = value;
         _changesMask.SetBit(index);
         _changesMask.SetBit(index + 1);
+        MarkValuesChanged();
 
         AddToObjectUpdateIfNeeded();
     }
@@ -808,6 +908,7 @@ void Object::SetFlag(uint16 index, uint32 newFlag)
     {
         m_uint32Values[index] = newval;
         _changesMask.SetBit(index);
+        MarkValuesChanged();
 
         AddToObjectUpdateIfNeeded();
     }
@@ -824,6 +925,7 @@ void Object::RemoveFlag(uint16 index, uint32 oldFlag)
     {
         m_uint32Values[index] = newval;
         _changesMask.SetBit(index);
+        MarkValuesChanged();
 
         AddToObjectUpdateIfNeeded();
     }
@@ -857,6 +959,7 @@ void Object::SetByteFlag(uint16 index, uint8 offset, uint8 newFlag)
     {
         m_uint32Values[index] |= uint32(uint32(newFlag) << (offset * 8));
         _changesMask.SetBit(index);
+        MarkValuesChanged();
 
         AddToObjectUpdateIfNeeded();
     }
@@ -871,6 +974,7 @@ void Object::RemoveByteFlag(uint16 index, uint8 offset, uint8 oldFlag)
     {
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << (offset * 8));
         _changesMask.SetBit(index);
+        MarkValuesChanged();
 
         AddToObjectUpdateIfNeeded();
     }
@@ -1567,7 +1671,7 @@ float WorldObject::GetSightRange(WorldObject const* target) const
     return 0.0f;
 }
 
-bool WorldObject::CanSeeOrDetect(WorldObject const* obj, bool ignoreStealth, bool distanceCheck, bool checkAlert) const
+bool WorldObject::CanSeeOrDetect(WorldObject const* obj, bool ignoreStealth, bool distanceCheck, bool checkAlert, float extraSightRange) const
 {
     if (this == obj)
         return true;
@@ -1619,7 +1723,7 @@ bool WorldObject::CanSeeOrDetect(WorldObject const* obj, bool ignoreStealth, boo
         if (!viewpoint)
             viewpoint = this;
 
-        if (!corpseCheck && !viewpoint->IsWithinDist(obj, GetSightRange(obj), false))
+        if (!corpseCheck && !viewpoint->IsWithinDist(obj, GetSightRange(obj) + extraSightRange, false))
             return false;
     }
 
@@ -1806,6 +1910,7 @@ bool WorldObject::CanDetectStealthOf(WorldObject const* obj, bool checkAlert) co
 void Object::ForceValuesUpdateAtIndex(uint32 i)
 {
     _changesMask.SetBit(i);
+    MarkValuesChanged();
     AddToObjectUpdateIfNeeded();
 }
 
@@ -31,6 +31,7 @@
 #include "SpellDefines.h"
 #include "UpdateFields.h"
 #include "UpdateMask.h"
+#include <atomic>
 #include <list>
 #include <set>
 #include <unordered_map>
@@ -159,8 +160,8 @@ class TC_GAME_API Object
         virtual void BuildUpdate(UpdateDataMapType&) { }
         void BuildFieldsUpdate(Player*, UpdateDataMapType &) const;
 
-        void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
-        void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= uint16(~flag); }
+        void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; MarkValuesChanged(); }
+        void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= uint16(~flag); MarkValuesChanged(); }
 
         // FG: some hacky helpers
         void ForceValuesUpdateAtIndex(uint32);
@@ -222,6 +223,17 @@ class TC_GAME_API Object
         void BuildMovementUpdate(ByteBuffer* data, uint16 flags) const;
         virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player const* target) const;
 
+        // Appends update mask and field values seen by target. The block is serialized once for all observers
+        // with the same visibleFlag and reused until any field changes, only per target fields are written again
+        void BuildSharedValuesUpdate(uint8 updateType, ByteBuffer* data, Player const* target, uint32 visibleFlag, uint32 const* flags) const;
+        virtual bool IsUpdateFieldSent(uint8 updateType, uint16 index, uint32 fieldFlags, uint32 visibleFlag) const;
+        virtual uint32 GetUpdateFieldValue(uint16 index) const { return m_uint32Values[index]; }
+        virtual bool IsUpdateFieldPerTarget(uint16 /*index*/) const { return false; }
+        virtual uint32 GetUpdateFieldValueForTarget(uint16 index, Player const* /*target*/) const { return m_uint32Values[index]; }
+        // must be called whenever fields, changes mask or notify flags are modified
+        void MarkValuesChanged() { m_valuesVersion.store(0, std::memory_order_relaxed); }
+        uint64 GetValuesVersion() const;
+
         uint16 m_objectType;
 
         TypeID m_objectTypeId;
@@ -240,6 +252,8 @@ class TC_GAME_API Object
 
         uint16 _fieldNotifyFlags;
 
+        mutable std::atomic<uint64> m_valuesVersion;    // 0 until requested after a change
+
         virtual bool AddToObjectUpdate() = 0;
         virtual void RemoveFromObjectUpdate() = 0;
         void AddToObjectUpdateIfNeeded();
@@ -309,6 +323,14 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         void GetContactPoint(WorldObject const* obj, float& x, float& y, float& z, float distance2d = CONTACT_DISTANCE) const;
 
         virtual float GetCombatReach() const { return 0.0f; } // overridden (only) in Unit
+
+        // keep the position index of the grid cell in sync, see GridPositionIndex
+        void Relocate(float x, float y) { Position::Relocate(x, y); UpdateGridPosition(); }
+        void Relocate(float x, float y, float z) { Position::Relocate(x, y, z); UpdateGridPosition(); }
+        void Relocate(float x, float y, float z, float o) { Position::Relocate(x, y, z, o); UpdateGridPosition(); }
+        void Relocate(Position const& pos) { Position::Relocate(pos); UpdateGridPosition(); }
+        void Relocate(Position const* pos) { Position::Relocate(pos); UpdateGridPosition(); }
+        virtual void UpdateGridPosition() { }
         void UpdateGroundPositionZ(float x, float y, float &z) const;
         void UpdateAllowedPositionZ(float x, float y, float &z, float* groundZ = nullptr) const;
 
@@ -386,7 +408,8 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         float GetGridActivationRange() const;
         float GetVisibilityRange() const;
         float GetSightRange(WorldObject const* target = nullptr) const;
-        bool CanSeeOrDetect(WorldObject const* obj, bool ignoreStealth = false, bool distanceCheck = false, bool checkAlert = false) const;
+        // extraSightRange: added to the sight range of the distance check
+        bool CanSeeOrDetect(WorldObject const* obj, bool ignoreStealth = false, bool distanceCheck = false, bool checkAlert = false, float extraSightRange = 0.0f) const;
 
         FlaggedValuesArray32<int32, uint32, StealthType, TOTAL_STEALTH_TYPES> m_stealth;
         FlaggedValuesArray32<int32, uint32, StealthType, TOTAL_STEALTH_TYPES> m_stealthDetect;
@@ -79,6 +79,7 @@ enum NotifyFlags
     NOTIFY_NONE                     = 0x00,
     NOTIFY_AI_RELOCATION            = 0x01,
     NOTIFY_VISIBILITY_CHANGED       = 0x02,
+    NOTIFY_VISIBILITY_FULL          = 0x04,                 // not only moved, the next visibility pass must re-check every object in range
     NOTIFY_ALL                      = 0xFF
 };
 
@@ -21,6 +21,8 @@
 #include "Opcodes.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include <atomic>
+#include <chrono>
 #include <zlib.h>
 
 UpdateData::UpdateData() : m_blockCount(0) { }
@@ -35,29 +37,100 @@ void UpdateData::AddOutOfRangeGUID(ObjectGuid guid)
     m_outOfRangeGUIDs.insert(guid);
 }
 
-void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
+// zlib state is large, keep one per thread and reset it for each packet instead of allocating it again
+class UpdateDataCompressor
+{
+    public:
+        UpdateDataCompressor() : _level(-1)
+        {
+            _stream.zalloc = (alloc_func)nullptr;
+            _stream.zfree = (free_func)nullptr;
+            _stream.opaque = (voidpf)nullptr;
+        }
+
+        ~UpdateDataCompressor()
+        {
+            if (_level >= 0)
+                deflateEnd(&_stream);
+        }
+
+        z_stream* Prepare(int level)
+        {
+            int z_res;
+            if (_level < 0)
+            {
+                z_res = deflateInit(&_stream, level);
+                if (z_res != Z_OK)
+                {
+                    TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+                    return nullptr;
+                }
+                _level = level;
+                return &_stream;
+            }
+
+            z_res = deflateReset(&_stream);
+            if (z_res != Z_OK)
+            {
+                TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflateReset) Error code: %i (%s)", z_res, zError(z_res));
+                return nullptr;
+            }
+
+            if (_level != level)
+            {
+                z_res = deflateParams(&_stream, level, Z_DEFAULT_STRATEGY);
+                if (z_res != Z_OK)
+                {
+                    TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflateParams) Error code: %i (%s)", z_res, zError(z_res));
+                    return nullptr;
+                }
+                _level = level;
+            }
+
+            return &_stream;
+        }
+
+    private:
+        z_stream _stream;
+        int _level;
+};
+
+static thread_local UpdateDataCompressor updateDataCompressor;
+
+static std::atomic<uint64> compressionBytesIn(0);
+static std::atomic<uint64> compressionBytesOut(0);
+static std::atomic<uint64> compressionTime(0);
+
+UpdateData::CompressionStats UpdateData::ResetCompressionStats()
 {
-    z_stream c_stream;
+    CompressionStats stats;
+    stats.BytesIn = compressionBytesIn.exchange(0);
+    stats.BytesOut = compressionBytesOut.exchange(0);
+    stats.TimeMicroseconds = compressionTime.exchange(0);
+    return stats;
+}
 
-    c_stream.zalloc = (alloc_func)nullptr;
-    c_stream.zfree = (free_func)nullptr;
-    c_stream.opaque = (voidpf)nullptr;
+void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
     // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld->getIntConfig(CONFIG_COMPRESSION));
-    if (z_res != Z_OK)
+    uint32 largePacketSize = sWorld->getIntConfig(CONFIG_COMPRESSION_LARGE_PACKET_SIZE);
+    int level = sWorld->getIntConfig(largePacketSize && uint32(src_size) >= largePacketSize ? CONFIG_COMPRESSION_LARGE_PACKET : CONFIG_COMPRESSION);
+
+    z_stream* c_stream = updateDataCompressor.Prepare(level);
+    if (!c_stream)
     {
-        TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
         *dst_size = 0;
         return;
     }
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+    c_stream->next_out = (Bytef*)dst;
+    c_stream->avail_out = *dst_size;
+    c_stream->next_in = (Bytef*)src;
+    c_stream->avail_in = (uInt)src_size;
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
+    int z_res = deflate(c_stream, Z_NO_FLUSH);
     if (z_res != Z_OK)
     {
         TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
@@ -65,14 +138,14 @@ void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
         return;
     }
 
-    if (c_stream.avail_in != 0)
+    if (c_stream->avail_in != 0)
     {
         TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflate not greedy)");
         *dst_size = 0;
         return;
     }
 
-    z_res = deflate(&c_stream, Z_FINISH);
+    z_res = deflate(c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
         TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflate should report Z_STREAM_END instead %i (%s)", z_res, zError(z_res));
@@ -80,15 +153,11 @@ void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+    *dst_size = c_stream->total_out;
 
-    *dst_size = c_stream.total_out;
+    compressionBytesIn += uint64(src_size);
+    compressionBytesOut += *dst_size;
+    compressionTime += uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
 }
 
 bool UpdateData::BuildPacket(WorldPacket* packet)
@@ -112,7 +181,7 @@ bool UpdateData::BuildPacket(WorldPacket* packet)
 
     size_t pSize = buf.wpos();                              // use real used data size
 
-    if (pSize > 100)                                       // compress large packets
+    if (pSize > sWorld->getIntConfig(CONFIG_COMPRESSION_THRESHOLD)) // compress large packets
     {
         uint32 destsize = compressBound(pSize);
         packet->resize(destsize + sizeof(uint32));
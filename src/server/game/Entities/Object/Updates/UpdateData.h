@@ -53,6 +53,15 @@ enum OBJECT_UPDATE_FLAGS
 class UpdateData
 {
     public:
+        // totals over all threads since last ResetCompressionStats()
+        struct CompressionStats
+        {
+            uint64 BytesIn = 0;
+            uint64 BytesOut = 0;
+            uint64 TimeMicroseconds = 0;
+        };
+        static CompressionStats ResetCompressionStats();
+
         UpdateData();
         UpdateData(UpdateData&& right) : m_blockCount(right.m_blockCount),
             m_outOfRangeGUIDs(std::move(right.m_outOfRangeGUIDs)),
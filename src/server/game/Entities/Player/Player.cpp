@@ -4547,11 +4547,11 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
                 playerguid.ToString().c_str(), charDelete_method);
 
             if (trans->GetSize() > 0)
-                CharacterDatabase.CommitTransaction(trans);
+                CharacterDatabase.CommitTransaction(trans, SQL_PRIORITY_SAVE, accountId);
             return;
     }
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQL_PRIORITY_SAVE, accountId);
 
     if (updateRealmChars)
         sWorld->UpdateRealmCharCount(accountId);
@@ -17351,6 +17351,7 @@ void Player::_LoadArenaTeamInfo(PreparedQueryResult result)
 {
     // arenateamid, played_week, played_season, personal_rating
     memset((void*)&m_uint32Values[PLAYER_FIELD_ARENA_TEAM_INFO_1_1], 0, sizeof(uint32) * MAX_ARENA_SLOT * ARENA_TEAM_END);
+    MarkValuesChanged();
 
     uint16 personalRatingCache[] = {0, 0, 0};
 
@@ -19622,7 +19623,8 @@ void Player::SaveToDB(bool create /*=false*/)
 
     SaveToDB(trans, create);
 
-    CharacterDatabase.CommitTransaction(trans);
+    // keeps a relog from loading the character before this save is done
+    CharacterDatabase.CommitTransaction(trans, SQL_PRIORITY_SAVE, GetSession()->GetAccountId());
 }
 
 void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create /* = false */)
@@ -22813,7 +22815,8 @@ void Player::UpdateVisibilityOf(WorldObject* target)
 {
     if (HaveAtClient(target))
     {
-        if (!CanSeeOrDetect(target, false, true))
+        // objects are destroyed a bit farther than they are created, no flapping at the edge of the range
+        if (!CanSeeOrDetect(target, false, true, false, sWorld->getFloatConfig(CONFIG_VISIBILITY_HYSTERESIS)))
         {
             if (target->GetTypeId() == TYPEID_UNIT)
                 BeforeVisibilityDestroy<Creature>(target->ToCreature(), this);
@@ -22902,7 +22905,7 @@ void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& vi
 {
     if (HaveAtClient(target))
     {
-        if (!CanSeeOrDetect(target, false, true))
+        if (!CanSeeOrDetect(target, false, true, false, sWorld->getFloatConfig(CONFIG_VISIBILITY_HYSTERESIS)))
         {
             BeforeVisibilityDestroy<T>(target, this);
 
@@ -22941,7 +22944,7 @@ void Player::UpdateObjectVisibility(bool forced)
         return;
 
     if (!forced)
-        AddToNotify(NOTIFY_VISIBILITY_CHANGED);
+        AddToNotify(NOTIFY_VISIBILITY_CHANGED | NOTIFY_VISIBILITY_FULL);
     else
     {
         Unit::UpdateObjectVisibility(true);
@@ -22953,7 +22956,7 @@ void Player::UpdateVisibilityForPlayer()
 {
     // updates visibility of all objects around point of view for current player
     Trinity::VisibleNotifier notifier(*this);
-    Cell::VisitAllObjects(m_seer, notifier, GetSightRange());
+    Cell::VisitAllObjects(m_seer, notifier, GetSightRange() + sWorld->getFloatConfig(CONFIG_VISIBILITY_HYSTERESIS));
     notifier.SendToSelf();   // send gathered data
 }
 
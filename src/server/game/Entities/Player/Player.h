@@ -901,6 +901,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
 
         void AddToWorld() override;
         void RemoveFromWorld() override;
+        void UpdateGridPosition() override { UpdatePositionInGrid(GetPositionX(), GetPositionY(), GetCombatReach()); }
 
         void SetObjectScale(float scale) override;
 
@@ -3746,6 +3746,8 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
     else
         m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+
+    InvalidateAuraModifierTotals(aurEff->GetAuraType());
 }
 
 // All aura base removes should go through this function!
@@ -4985,48 +4987,105 @@ int32 Unit::GetMaxNegativeAuraModifier(AuraType auraType, std::function<bool(Aur
     return modifier;
 }
 
+Unit::AuraModifierTotals Unit::GetAuraModifierTotals(AuraType auraType, AuraModifierFilter filter, int32 miscValue) const
+{
+    if (m_modAuras[auraType].empty())
+        return { 0, 1.0f, 0, 0 };
+
+    std::vector<CachedAuraModifierTotals>& cached = m_auraModifierTotals[auraType];
+    for (CachedAuraModifierTotals const& entry : cached)
+    {
+        if (entry.Filter != filter || entry.MiscValue != miscValue)
+            continue;
+
+#ifdef TRINITY_DEBUG
+        AuraModifierTotals const totals = CalculateAuraModifierTotals(auraType, filter, miscValue);
+        if (totals.Total != entry.Totals.Total || totals.Multiplier != entry.Totals.Multiplier
+            || totals.MaxPositive != entry.Totals.MaxPositive || totals.MaxNegative != entry.Totals.MaxNegative)
+            TC_LOG_ERROR("entities.unit", "Unit::GetAuraModifierTotals: stale totals of aura type %u (filter %u, misc %d) on %s, cached %d/%f/%d/%d, actual %d/%f/%d/%d",
+                uint32(auraType), uint32(filter), miscValue, GetGUID().ToString().c_str(),
+                entry.Totals.Total, entry.Totals.Multiplier, entry.Totals.MaxPositive, entry.Totals.MaxNegative,
+                totals.Total, totals.Multiplier, totals.MaxPositive, totals.MaxNegative);
+#endif
+
+        return entry.Totals;
+    }
+
+    if (cached.size() >= MAX_CACHED_AURA_MODIFIER_TOTALS)
+        cached.erase(cached.begin());
+
+    cached.push_back({ filter, miscValue, CalculateAuraModifierTotals(auraType, filter, miscValue) });
+    return cached.back().Totals;
+}
+
+Unit::AuraModifierTotals Unit::CalculateAuraModifierTotals(AuraType auraType, AuraModifierFilter filter, int32 miscValue) const
+{
+    std::map<SpellGroup, int32> sameEffectSpellGroup;
+    AuraModifierTotals totals = { 0, 1.0f, 0, 0 };
+
+    for (AuraEffect const* aurEff : GetAuraEffectsByType(auraType))
+    {
+        if (filter == AURA_MODIFIER_FILTER_MISC_MASK && (aurEff->GetMiscValue() & miscValue) == 0)
+            continue;
+        if (filter == AURA_MODIFIER_FILTER_MISC_VALUE && aurEff->GetMiscValue() != miscValue)
+            continue;
+
+        int32 const amount = aurEff->GetAmount();
+        totals.MaxPositive = std::max(totals.MaxPositive, amount);
+        totals.MaxNegative = std::min(totals.MaxNegative, amount);
+
+        // same stacking as GetTotalAuraModifier/GetTotalAuraMultiplier, only the highest amount of a Same Effect Stack Rule SpellGroup counts
+        if (!sSpellMgr->AddSameEffectStackRuleSpellGroups(aurEff->GetSpellInfo(), static_cast<uint32>(auraType), amount, sameEffectSpellGroup))
+        {
+            totals.Total += amount;
+            AddPct(totals.Multiplier, amount);
+        }
+    }
+
+    for (auto itr = sameEffectSpellGroup.begin(); itr != sameEffectSpellGroup.end(); ++itr)
+    {
+        totals.Total += itr->second;
+        AddPct(totals.Multiplier, itr->second);
+    }
+
+    return totals;
+}
+
 int32 Unit::GetTotalAuraModifier(AuraType auraType) const
 {
-    return GetTotalAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return GetAuraModifierTotals(auraType, AURA_MODIFIER_FILTER_NONE, 0).Total;
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auraType) const
 {
-    return GetTotalAuraMultiplier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return GetAuraModifierTotals(auraType, AURA_MODIFIER_FILTER_NONE, 0).Multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auraType) const
 {
-    return GetMaxPositiveAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return GetAuraModifierTotals(auraType, AURA_MODIFIER_FILTER_NONE, 0).MaxPositive;
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auraType) const
 {
-    return GetMaxNegativeAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return GetAuraModifierTotals(auraType, AURA_MODIFIER_FILTER_NONE, 0).MaxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    return GetTotalAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
-    {
-        if ((aurEff->GetMiscValue() & miscMask) != 0)
-            return true;
-        return false;
-    });
+    return GetAuraModifierTotals(auraType, AURA_MODIFIER_FILTER_MISC_MASK, int32(miscMask)).Total;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    return GetTotalAuraMultiplier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
-    {
-        if ((aurEff->GetMiscValue() & miscMask) != 0)
-            return true;
-        return false;
-    });
+    return GetAuraModifierTotals(auraType, AURA_MODIFIER_FILTER_MISC_MASK, int32(miscMask)).Multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auraType, uint32 miscMask, AuraEffect const* except /*= nullptr*/) const
 {
+    if (!except)
+        return GetAuraModifierTotals(auraType, AURA_MODIFIER_FILTER_MISC_MASK, int32(miscMask)).MaxPositive;
+
     return GetMaxPositiveAuraModifier(auraType, [miscMask, except](AuraEffect const* aurEff) -> bool
     {
         if (except != aurEff && (aurEff->GetMiscValue() & miscMask) != 0)
@@ -5037,52 +5096,27 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auraType, uint32 miscM
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    return GetMaxNegativeAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
-    {
-        if ((aurEff->GetMiscValue() & miscMask) != 0)
-            return true;
-        return false;
-    });
+    return GetAuraModifierTotals(auraType, AURA_MODIFIER_FILTER_MISC_MASK, int32(miscMask)).MaxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetTotalAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
-    {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
-    });
+    return GetAuraModifierTotals(auraType, AURA_MODIFIER_FILTER_MISC_VALUE, miscValue).Total;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetTotalAuraMultiplier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
-    {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
-    });
+    return GetAuraModifierTotals(auraType, AURA_MODIFIER_FILTER_MISC_VALUE, miscValue).Multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetMaxPositiveAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
-    {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
-    });
+    return GetAuraModifierTotals(auraType, AURA_MODIFIER_FILTER_MISC_VALUE, miscValue).MaxPositive;
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetMaxNegativeAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
-    {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
-    });
+    return GetAuraModifierTotals(auraType, AURA_MODIFIER_FILTER_MISC_VALUE, miscValue).MaxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByAffectMask(AuraType auraType, SpellInfo const* affectedSpell) const
@@ -14107,11 +14141,6 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player const* t
     if (!target)
         return;
 
-    ByteBuffer fieldBuffer;
-
-    UpdateMaskPacketBuilder updateMask(m_valuesCount);
-
-    uint32* flags = UnitUpdateFieldFlags;
     uint32 visibleFlag = UF_FLAG_PUBLIC;
 
     if (target == this)
@@ -14128,142 +14157,157 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player const* t
     if (plr && plr->IsInSameRaidWith(target))
         visibleFlag |= UF_FLAG_PARTY_MEMBER;
 
+    BuildSharedValuesUpdate(updateType, data, target, visibleFlag, UnitUpdateFieldFlags);
+}
+
+bool Unit::IsUpdateFieldSent(uint8 updateType, uint16 index, uint32 fieldFlags, uint32 visibleFlag) const
+{
+    return Object::IsUpdateFieldSent(updateType, index, fieldFlags, visibleFlag) ||
+        ((fieldFlags & visibleFlag) & UF_FLAG_SPECIAL_INFO) ||
+        (index == UNIT_FIELD_AURASTATE && HasFlag(UNIT_FIELD_AURASTATE, PER_CASTER_AURA_STATE_MASK));
+}
+
+uint32 Unit::GetUpdateFieldValue(uint16 index) const
+{
+    // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+    if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+    {
+        // convert from float to uint32 and send
+        return uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+    }
+    // there are some float values which may be negative or can't get negative due to other checks
+    else if ((index >= UNIT_FIELD_NEGSTAT0   && index <= UNIT_FIELD_NEGSTAT4) ||
+        (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+        (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+        (index >= UNIT_FIELD_POSSTAT0   && index <= UNIT_FIELD_POSSTAT4))
+    {
+        return uint32(m_floatValues[index]);
+    }
+
+    // send in current format (float as float, uint32 as uint32)
+    return m_uint32Values[index];
+}
+
+bool Unit::IsUpdateFieldPerTarget(uint16 index) const
+{
+    switch (index)
+    {
+        case UNIT_NPC_FLAGS:
+        case UNIT_FIELD_AURASTATE:
+        case UNIT_FIELD_FLAGS:
+        case UNIT_FIELD_DISPLAYID:
+        case UNIT_DYNAMIC_FLAGS:
+        case UNIT_FIELD_BYTES_2:
+        case UNIT_FIELD_FACTIONTEMPLATE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+uint32 Unit::GetUpdateFieldValueForTarget(uint16 index, Player const* target) const
+{
     Creature const* creature = ToCreature();
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    if (index == UNIT_NPC_FLAGS)
     {
-        if (_fieldNotifyFlags & flags[index] ||
-            ((flags[index] & visibleFlag) & UF_FLAG_SPECIAL_INFO) ||
-            ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)) ||
-            (index == UNIT_FIELD_AURASTATE && HasFlag(UNIT_FIELD_AURASTATE, PER_CASTER_AURA_STATE_MASK)))
-        {
-            updateMask.SetBit(index);
+        uint32 appendValue = m_uint32Values[UNIT_NPC_FLAGS];
 
-            if (index == UNIT_NPC_FLAGS)
-            {
-                uint32 appendValue = m_uint32Values[UNIT_NPC_FLAGS];
+        if (creature)
+            if (!target->CanSeeSpellClickOn(creature))
+                appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
 
-                if (creature)
-                    if (!target->CanSeeSpellClickOn(creature))
-                        appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
+        return appendValue;
+    }
+    else if (index == UNIT_FIELD_AURASTATE)
+    {
+        // Check per caster aura states to not enable using a spell in client if specified aura is not by target
+        return BuildAuraStateUpdateForTarget(target);
+    }
+    // Gamemasters should be always able to interact with units - remove uninteractible flag
+    else if (index == UNIT_FIELD_FLAGS)
+    {
+        uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
+        if (target->IsGameMaster())
+            appendValue &= ~UNIT_FLAG_UNINTERACTIBLE;
 
-                fieldBuffer << uint32(appendValue);
-            }
-            else if (index == UNIT_FIELD_AURASTATE)
-            {
-                // Check per caster aura states to not enable using a spell in client if specified aura is not by target
-                fieldBuffer << BuildAuraStateUpdateForTarget(target);
-            }
-            // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-            else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
-            {
-                // convert from float to uint32 and send
-                fieldBuffer << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
-            }
-            // there are some float values which may be negative or can't get negative due to other checks
-            else if ((index >= UNIT_FIELD_NEGSTAT0   && index <= UNIT_FIELD_NEGSTAT4) ||
-                (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                (index >= UNIT_FIELD_POSSTAT0   && index <= UNIT_FIELD_POSSTAT4))
-            {
-                fieldBuffer << uint32(m_floatValues[index]);
-            }
-            // Gamemasters should be always able to interact with units - remove uninteractible flag
-            else if (index == UNIT_FIELD_FLAGS)
-            {
-                uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
-                if (target->IsGameMaster())
-                    appendValue &= ~UNIT_FLAG_UNINTERACTIBLE;
+        return appendValue;
+    }
+    // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
+    else if (index == UNIT_FIELD_DISPLAYID)
+    {
+        uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAYID];
+        if (creature)
+        {
+            CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
 
-                fieldBuffer << uint32(appendValue);
-            }
-            // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
-            else if (index == UNIT_FIELD_DISPLAYID)
+            // this also applies for transform auras
+            if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(GetTransformSpell()))
             {
-                uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAYID];
-                if (creature)
+                for (SpellEffectInfo const& spellEffectInfo : transform->GetEffects())
                 {
-                    CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
-
-                    // this also applies for transform auras
-                    if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(GetTransformSpell()))
+                    if (spellEffectInfo.IsAura(SPELL_AURA_TRANSFORM))
                     {
-                        for (SpellEffectInfo const& spellEffectInfo : transform->GetEffects())
+                        if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(spellEffectInfo.MiscValue))
                         {
-                            if (spellEffectInfo.IsAura(SPELL_AURA_TRANSFORM))
-                            {
-                                if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(spellEffectInfo.MiscValue))
-                                {
-                                    cinfo = transformInfo;
-                                    break;
-                                }
-                            }
+                            cinfo = transformInfo;
+                            break;
                         }
                     }
-
-                    if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
-                        if (target->IsGameMaster())
-                            displayId = cinfo->GetFirstVisibleModel();
                 }
-
-                fieldBuffer << uint32(displayId);
             }
-            // hide lootable animation for unallowed players
-            else if (index == UNIT_DYNAMIC_FLAGS)
-            {
-                uint32 dynamicFlags = m_uint32Values[UNIT_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
 
-                if (creature)
-                {
-                    if (creature->hasLootRecipient())
-                    {
-                        dynamicFlags |= UNIT_DYNFLAG_TAPPED;
-                        if (creature->isTappedBy(target))
-                            dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
-                    }
-
-                    if (!target->isAllowedToLoot(creature))
-                        dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
-                }
+            if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
+                if (target->IsGameMaster())
+                    displayId = cinfo->GetFirstVisibleModel();
+        }
 
-                // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
-                if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
-                    if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
-                        dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
+        return displayId;
+    }
+    // hide lootable animation for unallowed players
+    else if (index == UNIT_DYNAMIC_FLAGS)
+    {
+        uint32 dynamicFlags = m_uint32Values[UNIT_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
 
-                fieldBuffer << dynamicFlags;
-            }
-            // FG: pretend that OTHER players in own group are friendly ("blue")
-            else if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
+        if (creature)
+        {
+            if (creature->hasLootRecipient())
             {
-                if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
-                {
-                    FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
-                    FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
-                    if (!ft1->IsFriendlyTo(*ft2))
-                    {
-                        if (index == UNIT_FIELD_BYTES_2)
-                            // Allow targetting opposite faction in party when enabled in config
-                            fieldBuffer << (m_uint32Values[UNIT_FIELD_BYTES_2] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
-                        else
-                            // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
-                            fieldBuffer << uint32(target->GetFaction());
-                    }
-                    else
-                        fieldBuffer << m_uint32Values[index];
-                }
-                else
-                    fieldBuffer << m_uint32Values[index];
+                dynamicFlags |= UNIT_DYNFLAG_TAPPED;
+                if (creature->isTappedBy(target))
+                    dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
             }
-            else
+
+            if (!target->isAllowedToLoot(creature))
+                dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
+        }
+
+        // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
+        if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
+            if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
+                dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
+
+        return dynamicFlags;
+    }
+    // FG: pretend that OTHER players in own group are friendly ("blue")
+    else if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
+    {
+        if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
+        {
+            FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
+            FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
+            if (!ft1->IsFriendlyTo(*ft2))
             {
-                // send in current format (float as float, uint32 as uint32)
-                fieldBuffer << m_uint32Values[index];
+                if (index == UNIT_FIELD_BYTES_2)
+                    // Allow targetting opposite faction in party when enabled in config
+                    return m_uint32Values[UNIT_FIELD_BYTES_2] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8); // this flag is at uint8 offset 1 !!
+                else
+                    // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
+                    return target->GetFaction();
             }
         }
     }
 
-    updateMask.AppendToPacket(data);
-    data->append(fieldBuffer);
+    return m_uint32Values[index];
 }
 
 int32 Unit::GetHighestExclusiveSameEffectSpellGroupValue(AuraEffect const* aurEff, AuraType auraType, bool checkMiscValue /*= false*/, int32 miscValue /*= 0*/) const
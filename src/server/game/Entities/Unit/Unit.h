@@ -20,6 +20,7 @@
 
 #include "Object.h"
 #include "CombatManager.h"
+#include "NodePool.h"
 #include "SpellAuraDefines.h"
 #include "ThreatManager.h"
 #include "Timer.h"
@@ -776,20 +777,20 @@ class TC_GAME_API Unit : public WorldObject
         typedef std::set<Unit*> ControlList;
         typedef std::vector<Unit*> UnitVector;
 
-        typedef std::multimap<uint32, Aura*> AuraMap;
+        typedef std::multimap<uint32, Aura*, std::less<uint32>, NodePoolAllocator<std::pair<uint32 const, Aura*>>> AuraMap;
         typedef std::pair<AuraMap::const_iterator, AuraMap::const_iterator> AuraMapBounds;
         typedef std::pair<AuraMap::iterator, AuraMap::iterator> AuraMapBoundsNonConst;
 
-        typedef std::multimap<uint32,  AuraApplication*> AuraApplicationMap;
+        typedef std::multimap<uint32, AuraApplication*, std::less<uint32>, NodePoolAllocator<std::pair<uint32 const, AuraApplication*>>> AuraApplicationMap;
         typedef std::pair<AuraApplicationMap::const_iterator, AuraApplicationMap::const_iterator> AuraApplicationMapBounds;
         typedef std::pair<AuraApplicationMap::iterator, AuraApplicationMap::iterator> AuraApplicationMapBoundsNonConst;
 
-        typedef std::multimap<AuraStateType,  AuraApplication*> AuraStateAurasMap;
+        typedef std::multimap<AuraStateType, AuraApplication*, std::less<AuraStateType>, NodePoolAllocator<std::pair<AuraStateType const, AuraApplication*>>> AuraStateAurasMap;
         typedef std::pair<AuraStateAurasMap::const_iterator, AuraStateAurasMap::const_iterator> AuraStateAurasMapBounds;
 
-        typedef std::list<AuraEffect*> AuraEffectList;
-        typedef std::list<Aura*> AuraList;
-        typedef std::list<AuraApplication*> AuraApplicationList;
+        typedef std::list<AuraEffect*, NodePoolAllocator<AuraEffect*>> AuraEffectList;
+        typedef std::list<Aura*, NodePoolAllocator<Aura*>> AuraList;
+        typedef std::list<AuraApplication*, NodePoolAllocator<AuraApplication*>> AuraApplicationList;
         typedef std::array<DiminishingReturn, DIMINISHING_MAX> Diminishing;
 
         typedef std::vector<std::pair<uint8 /*procEffectMask*/, AuraApplication*>> AuraApplicationProcContainer;
@@ -838,7 +839,7 @@ class TC_GAME_API Unit : public WorldObject
         bool CanDualWield() const { return m_canDualWield; }
         virtual void SetCanDualWield(bool value) { m_canDualWield = value; }
         float GetCombatReach() const override { return GetFloatValue(UNIT_FIELD_COMBATREACH); }
-        void SetCombatReach(float combatReach) { SetFloatValue(UNIT_FIELD_COMBATREACH, combatReach); }
+        void SetCombatReach(float combatReach) { SetFloatValue(UNIT_FIELD_COMBATREACH, combatReach); UpdateGridPosition(); }
         float GetBoundingRadius() const { return GetFloatValue(UNIT_FIELD_BOUNDINGRADIUS); }
         void SetBoundingRadius(float boundingRadius) { SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, boundingRadius); }
         bool IsWithinCombatRange(Unit const* obj, float dist2compare) const;
@@ -1332,6 +1333,7 @@ class TC_GAME_API Unit : public WorldObject
         void _UnapplyAura(AuraApplication* aurApp, AuraRemoveMode removeMode);
         void _RemoveNoStackAurasDueToAura(Aura* aura);
         void _RegisterAuraEffect(AuraEffect* aurEff, bool apply);
+        void InvalidateAuraModifierTotals(AuraType auraType) { m_auraModifierTotals.erase(auraType); }
 
         // m_ownedAuras container management
         AuraMap      & GetOwnedAuras()       { return m_ownedAuras; }
@@ -1845,6 +1847,10 @@ class TC_GAME_API Unit : public WorldObject
         explicit Unit (bool isWorldObject);
 
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player const* target) const override;
+        bool IsUpdateFieldSent(uint8 updateType, uint16 index, uint32 fieldFlags, uint32 visibleFlag) const override;
+        uint32 GetUpdateFieldValue(uint16 index) const override;
+        bool IsUpdateFieldPerTarget(uint16 index) const override;
+        uint32 GetUpdateFieldValueForTarget(uint16 index, Player const* target) const override;
 
         void _UpdateSpells(uint32 time);
         void _DeleteRemovedAuras();
@@ -1940,6 +1946,37 @@ class TC_GAME_API Unit : public WorldObject
 
         void ProcSkillsAndReactives(bool isVictim, Unit* procTarget, uint32 typeMask, uint32 hitMask, WeaponAttackType attType);
 
+        // Aura modifier getters without a custom predicate are served from per aura type totals,
+        // calculated in a single walk of m_modAuras and dropped whenever an effect of that type is registered,
+        // unregistered or changes amount
+        enum AuraModifierFilter : uint8
+        {
+            AURA_MODIFIER_FILTER_NONE,
+            AURA_MODIFIER_FILTER_MISC_MASK,
+            AURA_MODIFIER_FILTER_MISC_VALUE
+        };
+
+        struct AuraModifierTotals
+        {
+            int32 Total;
+            float Multiplier;
+            int32 MaxPositive;
+            int32 MaxNegative;
+        };
+
+        // (filter, misc value) pairs kept per aura type, oldest is dropped first (misc values like skill ids are unbounded)
+        static constexpr std::size_t MAX_CACHED_AURA_MODIFIER_TOTALS = 16;
+
+        struct CachedAuraModifierTotals
+        {
+            AuraModifierFilter Filter;
+            int32 MiscValue;
+            AuraModifierTotals Totals;
+        };
+
+        AuraModifierTotals GetAuraModifierTotals(AuraType auraType, AuraModifierFilter filter, int32 miscValue) const;
+        AuraModifierTotals CalculateAuraModifierTotals(AuraType auraType, AuraModifierFilter filter, int32 miscValue) const;
+
     protected:
         void SetFeared(bool apply);
         void SetConfused(bool apply);
@@ -1975,6 +2012,8 @@ class TC_GAME_API Unit : public WorldObject
         int8 m_comboPoints;
         std::unordered_set<Unit*> m_ComboPointHolders;
 
+        mutable std::unordered_map<uint32 /*AuraType*/, std::vector<CachedAuraModifierTotals>> m_auraModifierTotals;
+
         uint32 _lastExtraAttackSpell;
         std::unordered_map<ObjectGuid /*guid*/, uint32 /*count*/> extraAttacksTargets;
         ObjectGuid _lastDamagedTargetGuid;
@@ -9511,9 +9511,10 @@ void ObjectMgr::LoadCreatureDefaultTrainers()
 uint32 ObjectMgr::LoadReferenceVendor(int32 vendor, int32 item, std::set<uint32>* skip_vendors)
 {
     // find all items from the reference vendor
+    // reference vendors are shared by many vendors, fetch each of them once
     WorldDatabasePreparedStatement* stmt = WorldDatabase.GetPreparedStatement(WORLD_SEL_NPC_VENDOR_REF);
     stmt->setUInt32(0, uint32(item));
-    PreparedQueryResult result = WorldDatabase.Query(stmt);
+    PreparedQueryResult result = WorldDatabase.CachedQuery(stmt);
 
     if (!result)
         return 0;
@@ -0,0 +1,121 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_GRIDPOSITIONINDEX_H
+#define TRINITY_GRIDPOSITIONINDEX_H
+
+/*
+  @class GridPositionIndex
+  Positions and combat reach of the objects of one cell container, kept in
+  separate arrays. Range searches test a whole batch of objects in a branch
+  free pass over the coordinates (vectorized by the compiler) and only touch
+  the objects that can be in range. Built by GridRefManager on first use after
+  an object entered or left the cell, kept up to date by WorldObject::Relocate.
+  The arrays must not be rebuilt while a search is visiting them.
+*/
+
+#include "Define.h"
+#include "Errors.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+// added to every search radius, covers float rounding
+#define GRID_POSITION_INDEX_SLACK 0.5f
+// cells holding fewer objects of a type are searched without the index
+#define GRID_POSITION_INDEX_MIN_OBJECTS 8
+
+template<class OBJECT>
+class GridPositionIndex
+{
+    public:
+        void Clear()
+        {
+            ASSERT(!_visits, "GridPositionIndex rebuilt during a visit");
+            _x.clear();
+            _y.clear();
+            _reach.clear();
+            _objects.clear();
+        }
+
+        uint32 Add(OBJECT* object, float x, float y, float reach)
+        {
+            ASSERT(!_visits, "GridPositionIndex rebuilt during a visit");
+            _x.push_back(x);
+            _y.push_back(y);
+            _reach.push_back(reach);
+            _objects.push_back(object);
+            return uint32(_objects.size() - 1);
+        }
+
+        void Update(uint32 slot, float x, float y, float reach)
+        {
+            _x[slot] = x;
+            _y[slot] = y;
+            _reach[slot] = reach;
+        }
+
+        bool IsVisited() const { return _visits != 0; }
+
+        /** Calls visitor, in the order objects were added, for every object whose 2d distance to (x, y)
+            is at most radius + its combat reach. Stops when visitor returns false.
+            Positions may be updated by the visitor, objects must not be added.
+         */
+        template<class VISITOR>
+        void VisitInRange(float x, float y, float radius, VISITOR&& visitor) const
+        {
+            VisitGuard guard(_visits);
+            std::array<uint8, BATCH_SIZE> inRange;
+            std::size_t const count = _objects.size();
+            for (std::size_t begin = 0; begin < count; begin += BATCH_SIZE)
+            {
+                std::size_t const batch = std::min(count - begin, BATCH_SIZE);
+                float const* xs = &_x[begin];
+                float const* ys = &_y[begin];
+                float const* reaches = &_reach[begin];
+
+                for (std::size_t i = 0; i < batch; ++i)
+                {
+                    float const dx = xs[i] - x;
+                    float const dy = ys[i] - y;
+                    float const maxDist = radius + reaches[i] + GRID_POSITION_INDEX_SLACK;
+                    inRange[i] = uint8(dx * dx + dy * dy <= maxDist * maxDist);
+                }
+
+                for (std::size_t i = 0; i < batch; ++i)
+                    if (inRange[i] && !visitor(_objects[begin + i]))
+                        return;
+            }
+        }
+
+    private:
+        static constexpr std::size_t BATCH_SIZE = 64;
+
+        struct VisitGuard
+        {
+            explicit VisitGuard(uint32& visits) : _visits(visits) { ++_visits; }
+            ~VisitGuard() { --_visits; }
+            uint32& _visits;
+        };
+
+        std::vector<float> _x;
+        std::vector<float> _y;
+        std::vector<float> _reach;
+        std::vector<OBJECT*> _objects;
+        mutable uint32 _visits = 0;
+};
+#endif
@@ -18,7 +18,9 @@
 #ifndef _GRIDREFMANAGER
 #define _GRIDREFMANAGER
 
+#include "GridPositionIndex.h"
 #include "RefManager.h"
+#include <memory>
 
 template<class OBJECT>
 class GridReference;
@@ -34,5 +36,45 @@ class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
 
         iterator begin() { return iterator(getFirst()); }
         iterator end() { return iterator(nullptr); }
+
+        // references invalidate the position index while unlinking, it must still be alive then
+        ~GridRefManager() { this->clearReferences(); }
+
+        void InvalidatePositionIndex() { _positionIndexValid = false; }
+
+        void UpdatePosition(uint32 slot, float x, float y, float reach)
+        {
+            if (_positionIndexValid)
+                _positionIndex->Update(slot, x, y, reach);
+        }
+
+        // Builds the index if objects entered or left the cell since the last search
+        // return: nullptr if the index is outdated and cannot be rebuilt because a search is still visiting it
+        GridPositionIndex<OBJECT> const* GetPositionIndex()
+        {
+            if (!_positionIndexValid)
+            {
+                if (_positionIndex && _positionIndex->IsVisited())
+                    return nullptr;
+
+                if (!_positionIndex)
+                    _positionIndex = std::make_unique<GridPositionIndex<OBJECT>>();
+
+                _positionIndex->Clear();
+                for (iterator itr = begin(); itr != end(); ++itr)
+                {
+                    OBJECT* object = itr->GetSource();
+                    object->SetGridPositionSlot(_positionIndex->Add(object, object->GetPositionX(), object->GetPositionY(), object->GetCombatReach()));
+                }
+
+                _positionIndexValid = true;
+            }
+
+            return _positionIndex.get();
+        }
+
+    private:
+        std::unique_ptr<GridPositionIndex<OBJECT>> _positionIndex;
+        bool _positionIndexValid = false;
 };
 #endif
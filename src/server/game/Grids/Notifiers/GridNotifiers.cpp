@@ -23,9 +23,50 @@
 #include "Transport.h"
 #include "ObjectAccessor.h"
 #include "CellImpl.h"
+#include "World.h"
 
 using namespace Trinity;
 
+bool Trinity::CanUsePositionIndex(uint32 objectCount)
+{
+    // walking a few objects is cheaper than building the index
+    return objectCount >= GRID_POSITION_INDEX_MIN_OBJECTS && sWorld->getBoolConfig(CONFIG_GRID_POSITION_PREFILTER);
+}
+
+// player only moved since the last visibility pass, the pass may keep objects well inside the range without checking them
+static bool IsMoveOnlyVisibilityUpdate(Player const* player)
+{
+    return player->m_seer == player && player->IsAlive() && !player->isNeedNotify(NOTIFY_VISIBILITY_FULL)
+        && sWorld->getBoolConfig(CONFIG_VISIBILITY_INCREMENTAL);
+}
+
+// player has a pending visibility pass that will check an object changed in this tick, no need to check it now
+// move-only passes skip objects without pending changes, so they must run before the notify flags are reset
+static bool HasPendingVisibilityUpdate(Player const* player)
+{
+    if (!player->m_seer->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
+        return false;
+
+    return !IsMoveOnlyVisibilityUpdate(player) || player->GetMap()->IsRelocationNotifyDue(Trinity::ComputeGridCoord(player->GetPositionX(), player->GetPositionY()));
+}
+
+bool VisibleNotifier::StaysVisible(WorldObject const* target) const
+{
+    // anything that changed besides positions is re-checked
+    if (!i_movedOnly || target->isNeedNotify(NOTIFY_VISIBILITY_CHANGED) || !i_player.HaveAtClient(target))
+        return false;
+
+    // stealth detection depends on distance, vehicle accessories on visibility of their vehicle
+    if (target->m_stealth.GetFlags() || target->m_invisibility.GetFlags())
+        return false;
+
+    if (Unit const* unit = target->ToUnit())
+        if (unit->GetVehicleBase())
+            return false;
+
+    return i_player.IsWithinDist(target, i_player.GetSightRange(target), false);
+}
+
 void VisibleNotifier::SendToSelf()
 {
     // at this moment i_clientGUIDs have guids that not iterate at grid level checks
@@ -148,9 +189,10 @@ void PlayerRelocationNotifier::Visit(PlayerMapType &m)
 
         vis_guids.erase(player->GetGUID());
 
-        i_player.UpdateVisibilityOf(player, i_data, i_visibleNow);
+        if (!StaysVisible(player))
+            i_player.UpdateVisibilityOf(player, i_data, i_visibleNow);
 
-        if (player->m_seer->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
+        if (HasPendingVisibilityUpdate(player))
             continue;
 
         player->UpdateVisibilityOf(&i_player);
@@ -167,7 +209,8 @@ void PlayerRelocationNotifier::Visit(CreatureMapType &m)
 
         vis_guids.erase(c->GetGUID());
 
-        i_player.UpdateVisibilityOf(c, i_data, i_visibleNow);
+        if (!StaysVisible(c))
+            i_player.UpdateVisibilityOf(c, i_data, i_visibleNow);
 
         if (relocated_for_ai && !c->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
             CreatureUnitRelocationWorker(c, &i_player);
@@ -180,7 +223,7 @@ void CreatureRelocationNotifier::Visit(PlayerMapType &m)
     {
         Player* player = iter->GetSource();
 
-        if (!player->m_seer->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
+        if (!HasPendingVisibilityUpdate(player))
             player->UpdateVisibilityOf(&i_creature);
 
         CreatureUnitRelocationWorker(&i_creature, player);
@@ -233,7 +276,7 @@ void DelayedUnitRelocation::Visit(PlayerMapType &m)
         if (player != viewPoint && !viewPoint->IsPositionValid())
             continue;
 
-        PlayerRelocationNotifier relocate(*player);
+        PlayerRelocationNotifier relocate(*player, IsMoveOnlyVisibilityUpdate(player));
         Cell::VisitAllObjects(viewPoint, relocate, i_radius, false);
         relocate.SendToSelf();
     }
@@ -38,10 +38,12 @@ namespace Trinity
         UpdateData i_data;
         std::set<Unit*> i_visibleNow;
         GuidUnorderedSet vis_guids;
+        bool i_movedOnly;
 
-        VisibleNotifier(Player &player) : i_player(player), vis_guids(player.m_clientGUIDs) { }
+        VisibleNotifier(Player &player, bool movedOnly = false) : i_player(player), vis_guids(player.m_clientGUIDs), i_movedOnly(movedOnly) { }
         template<class T> void Visit(GridRefManager<T> &m);
         void SendToSelf(void);
+        bool StaysVisible(WorldObject const* target) const;
     };
 
     struct VisibleChangesNotifier
@@ -57,7 +59,7 @@ namespace Trinity
 
     struct TC_GAME_API PlayerRelocationNotifier : public VisibleNotifier
     {
-        PlayerRelocationNotifier(Player &player) : VisibleNotifier(player) { }
+        PlayerRelocationNotifier(Player &player, bool movedOnly) : VisibleNotifier(player, movedOnly) { }
 
         template<class T> void Visit(GridRefManager<T> &m) { VisibleNotifier::Visit(m); }
         void Visit(CreatureMapType &);
@@ -192,6 +194,50 @@ namespace Trinity
 
     // WorldObject searchers & workers
 
+    // Checks providing GetSearchCircle(x, y, radius) accept only objects within radius
+    // (plus their combat reach) of (x, y) in 2d, searchers can skip the rest using the cell position index
+    template<class Check, class = void>
+    struct HasSearchCircle : std::false_type { };
+
+    template<class Check>
+    struct HasSearchCircle<Check, std::void_t<decltype(std::declval<Check const&>().GetSearchCircle(std::declval<float&>(), std::declval<float&>(), std::declval<float&>()))>> : std::true_type { };
+
+    TC_GAME_API bool CanUsePositionIndex(uint32 objectCount);
+
+    // Calls visitor, in container order, for the objects of the cell that can pass check, until visitor returns false
+    template<class T, class Check, class Visitor>
+    void VisitCandidates(GridRefManager<T>& m, Check const& check, Visitor&& visitor)
+    {
+        if constexpr (HasSearchCircle<Check>::value)
+        {
+            float x, y, radius;
+            if (CanUsePositionIndex(m.getSize()) && check.GetSearchCircle(x, y, radius))
+            {
+                if (GridPositionIndex<T> const* index = m.GetPositionIndex())
+                {
+                    index->VisitInRange(x, y, radius, visitor);
+                    return;
+                }
+            }
+        }
+
+        for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+            if (!visitor(itr->GetSource()))
+                return;
+    }
+
+    // Search circle of IsWithinDistInMap(u, range) checks, gameobjects measure by their model and passengers in transport space
+    inline bool GetWithinDistSearchCircle(WorldObject const* obj, float range, float& x, float& y, float& radius)
+    {
+        if (obj->GetTypeId() == TYPEID_GAMEOBJECT || obj->GetTransport())
+            return false;
+
+        x = obj->GetPositionX();
+        y = obj->GetPositionY();
+        radius = range + obj->GetCombatReach();
+        return true;
+    }
+
     // Generic base class to insert elements into arbitrary containers using push_back
     template<typename Type>
     class ContainerInserter
@@ -971,6 +1017,8 @@ namespace Trinity
                 return false;
             }
 
+            bool GetSearchCircle(float& x, float& y, float& radius) const { return GetWithinDistSearchCircle(i_obj, i_range, x, y, radius); }
+
         private:
             WorldObject const* i_obj;
             Unit const* i_funit;
@@ -1003,6 +1051,8 @@ namespace Trinity
                 return true;
             }
 
+            bool GetSearchCircle(float& x, float& y, float& radius) const { return GetWithinDistSearchCircle(i_obj, i_range, x, y, radius); }
+
         private:
             WorldObject const* i_obj;
             float i_range;
@@ -1034,6 +1084,14 @@ namespace Trinity
                 return !i_playerOnly || u->GetTypeId() == TYPEID_PLAYER;
             }
 
+            bool GetSearchCircle(float& x, float& y, float& radius) const
+            {
+                x = i_obj->GetPositionX();
+                y = i_obj->GetPositionY();
+                radius = i_range + (i_incOwnRadius ? i_obj->GetCombatReach() : 0.0f);
+                return true;
+            }
+
         private:
             WorldObject const* i_obj;
             Unit const* i_funit;
@@ -1077,6 +1135,14 @@ namespace Trinity
                 return u->IsInMap(_source) && u->InSamePhase(_source) && u->IsWithinDoubleVerticalCylinder(_source, searchRadius, searchRadius);
             }
 
+            bool GetSearchCircle(float& x, float& y, float& radius) const
+            {
+                x = _source->GetPositionX();
+                y = _source->GetPositionY();
+                radius = _range + (i_incOwnRadius ? _source->GetCombatReach() : 0.0f);
+                return true;
+            }
+
         private:
             WorldObject const* _source;
             Unit const* _refUnit;
@@ -1100,6 +1166,8 @@ namespace Trinity
                 return false;
             }
 
+            bool GetSearchCircle(float& x, float& y, float& radius) const { return GetWithinDistSearchCircle(i_obj, i_range, x, y, radius); }
+
         private:
             WorldObject const* i_obj;
             float i_range;
@@ -1123,6 +1191,8 @@ namespace Trinity
                 return false;
             }
 
+            bool GetSearchCircle(float& x, float& y, float& radius) const { return GetWithinDistSearchCircle(i_obj, i_range, x, y, radius); }
+
         private:
             WorldObject const* i_obj;
             Unit const* i_funit;
@@ -1161,6 +1231,14 @@ namespace Trinity
                 return u->IsInMap(i_obj) && u->InSamePhase(i_obj) && u->IsWithinDoubleVerticalCylinder(i_obj, searchRadius, searchRadius);
             }
 
+            bool GetSearchCircle(float& x, float& y, float& radius) const
+            {
+                x = i_obj->GetPositionX();
+                y = i_obj->GetPositionY();
+                radius = i_range + (i_incOwnRadius ? i_obj->GetCombatReach() : 0.0f);
+                return true;
+            }
+
         private:
             WorldObject const* i_obj;
             Unit const* i_funit;
@@ -1227,6 +1305,8 @@ namespace Trinity
                 return true;
             }
 
+            bool GetSearchCircle(float& x, float& y, float& radius) const { return GetWithinDistSearchCircle(me, m_range, x, y, radius); }
+
         private:
             Creature const* me;
             float m_range;
@@ -1263,6 +1343,8 @@ namespace Trinity
                 return true;
             }
 
+            bool GetSearchCircle(float& x, float& y, float& radius) const { return GetWithinDistSearchCircle(me, m_range, x, y, radius); }
+
         private:
             Creature const* me;
             float m_range;
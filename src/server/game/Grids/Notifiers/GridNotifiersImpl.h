@@ -33,7 +33,8 @@ inline void Trinity::VisibleNotifier::Visit(GridRefManager<T> &m)
     for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         vis_guids.erase(iter->GetSource()->GetGUID());
-        i_player.UpdateVisibilityOf(iter->GetSource(), i_data, i_visibleNow);
+        if (!StaysVisible(iter->GetSource()))
+            i_player.UpdateVisibilityOf(iter->GetSource(), i_data, i_visibleNow);
     }
 }
 
@@ -74,17 +75,14 @@ void Trinity::WorldObjectSearcher<Check>::Visit(PlayerMapType &m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(m, i_check, [this](Player* player)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (!player->InSamePhase(i_phaseMask) || !i_check(player))
+            return true;
 
-        if (i_check(itr->GetSource()))
-        {
-            i_object = itr->GetSource();
-            return;
-        }
-    }
+        i_object = player;
+        return false;
+    });
 }
 
 template<class Check>
@@ -97,17 +95,14 @@ void Trinity::WorldObjectSearcher<Check>::Visit(CreatureMapType &m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(m, i_check, [this](Creature* creature)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (!creature->InSamePhase(i_phaseMask) || !i_check(creature))
+            return true;
 
-        if (i_check(itr->GetSource()))
-        {
-            i_object = itr->GetSource();
-            return;
-        }
-    }
+        i_object = creature;
+        return false;
+    });
 }
 
 template<class Check>
@@ -178,14 +173,12 @@ void Trinity::WorldObjectLastSearcher<Check>::Visit(PlayerMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_PLAYER))
         return;
 
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(m, i_check, [this](Player* player)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
-    }
+        if (player->InSamePhase(i_phaseMask) && i_check(player))
+            i_object = player;
+        return true;
+    });
 }
 
 template<class Check>
@@ -194,14 +187,12 @@ void Trinity::WorldObjectLastSearcher<Check>::Visit(CreatureMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CREATURE))
         return;
 
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(m, i_check, [this](Creature* creature)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
-    }
+        if (creature->InSamePhase(i_phaseMask) && i_check(creature))
+            i_object = creature;
+        return true;
+    });
 }
 
 template<class Check>
@@ -242,9 +233,12 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(PlayerMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_PLAYER))
         return;
 
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->GetSource()))
-            Insert(itr->GetSource());
+    VisitCandidates(m, i_check, [this](Player* player)
+    {
+        if (i_check(player))
+            Insert(player);
+        return true;
+    });
 }
 
 template<class Check>
@@ -253,9 +247,12 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(CreatureMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CREATURE))
         return;
 
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->GetSource()))
-            Insert(itr->GetSource());
+    VisitCandidates(m, i_check, [this](Creature* creature)
+    {
+        if (i_check(creature))
+            Insert(creature);
+        return true;
+    });
 }
 
 template<class Check>
@@ -344,17 +341,14 @@ void Trinity::UnitSearcher<Check>::Visit(CreatureMapType &m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(m, i_check, [this](Creature* creature)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (!creature->InSamePhase(i_phaseMask) || !i_check(creature))
+            return true;
 
-        if (i_check(itr->GetSource()))
-        {
-            i_object = itr->GetSource();
-            return;
-        }
-    }
+        i_object = creature;
+        return false;
+    });
 }
 
 template<class Check>
@@ -364,61 +358,58 @@ void Trinity::UnitSearcher<Check>::Visit(PlayerMapType &m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(m, i_check, [this](Player* player)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (!player->InSamePhase(i_phaseMask) || !i_check(player))
+            return true;
 
-        if (i_check(itr->GetSource()))
-        {
-            i_object = itr->GetSource();
-            return;
-        }
-    }
+        i_object = player;
+        return false;
+    });
 }
 
 template<class Check>
 void Trinity::UnitLastSearcher<Check>::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(m, i_check, [this](Creature* creature)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
-    }
+        if (creature->InSamePhase(i_phaseMask) && i_check(creature))
+            i_object = creature;
+        return true;
+    });
 }
 
 template<class Check>
 void Trinity::UnitLastSearcher<Check>::Visit(PlayerMapType &m)
 {
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(m, i_check, [this](Player* player)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
-    }
+        if (player->InSamePhase(i_phaseMask) && i_check(player))
+            i_object = player;
+        return true;
+    });
 }
 
 template<class Check>
 void Trinity::UnitListSearcher<Check>::Visit(PlayerMapType &m)
 {
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (itr->GetSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->GetSource()))
-                Insert(itr->GetSource());
+    VisitCandidates(m, i_check, [this](Player* player)
+    {
+        if (player->InSamePhase(i_phaseMask) && i_check(player))
+            Insert(player);
+        return true;
+    });
 }
 
 template<class Check>
 void Trinity::UnitListSearcher<Check>::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (itr->GetSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->GetSource()))
-                Insert(itr->GetSource());
+    VisitCandidates(m, i_check, [this](Creature* creature)
+    {
+        if (creature->InSamePhase(i_phaseMask) && i_check(creature))
+            Insert(creature);
+        return true;
+    });
 }
 
 // Creature searchers
@@ -430,48 +421,47 @@ void Trinity::CreatureSearcher<Check>::Visit(CreatureMapType &m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(m, i_check, [this](Creature* creature)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (!creature->InSamePhase(i_phaseMask) || !i_check(creature))
+            return true;
 
-        if (i_check(itr->GetSource()))
-        {
-            i_object = itr->GetSource();
-            return;
-        }
-    }
+        i_object = creature;
+        return false;
+    });
 }
 
 template<class Check>
 void Trinity::CreatureLastSearcher<Check>::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(m, i_check, [this](Creature* creature)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
-    }
+        if (creature->InSamePhase(i_phaseMask) && i_check(creature))
+            i_object = creature;
+        return true;
+    });
 }
 
 template<class Check>
 void Trinity::CreatureListSearcher<Check>::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (itr->GetSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->GetSource()))
-                Insert(itr->GetSource());
+    VisitCandidates(m, i_check, [this](Creature* creature)
+    {
+        if (creature->InSamePhase(i_phaseMask) && i_check(creature))
+            Insert(creature);
+        return true;
+    });
 }
 
 template<class Check>
 void Trinity::PlayerListSearcher<Check>::Visit(PlayerMapType &m)
 {
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (itr->GetSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->GetSource()))
-                Insert(itr->GetSource());
+    VisitCandidates(m, i_check, [this](Player* player)
+    {
+        if (player->InSamePhase(i_phaseMask) && i_check(player))
+            Insert(player);
+        return true;
+    });
 }
 
 template<class Check>
@@ -481,30 +471,25 @@ void Trinity::PlayerSearcher<Check>::Visit(PlayerMapType &m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(m, i_check, [this](Player* player)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (!player->InSamePhase(i_phaseMask) || !i_check(player))
+            return true;
 
-        if (i_check(itr->GetSource()))
-        {
-            i_object = itr->GetSource();
-            return;
-        }
-    }
+        i_object = player;
+        return false;
+    });
 }
 
 template<class Check>
 void Trinity::PlayerLastSearcher<Check>::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(m, i_check, [this](Player* player)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
-    }
+        if (player->InSamePhase(i_phaseMask) && i_check(player))
+            i_object = player;
+        return true;
+    });
 }
 
 template<class Builder>
@@ -60,6 +60,7 @@ BOOST_1_74_FIBONACCI_HEAP_MSVC_COMPILE_FIX(RespawnListContainer::value_type)
 //npcbot
 #include "botdatamgr.h"
 #include "botmgr.h"
+#include "botperception.h"
 //end npcbot
 
 u_map_magic MapMagic        = { {'M','A','P','S'} };
@@ -280,8 +281,11 @@ _creatureToMoveLock(false), _gameObjectsToMoveLock(false), _dynamicObjectsToMove
 i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
 m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
-m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsUpdateIter(_transports.end()),
+_transportsUpdateIter(_transports.end()),
 i_gridExpiry(expiry),
+//npcbot
+_botPerceptionCache(std::make_unique<BotPerceptionCache>(this)),
+//end npcbot
 i_scriptLock(false), _respawnCheckTimer(0)
 {
     m_parentMap = (_parent ? _parent : this);
@@ -321,6 +325,11 @@ void Map::AddToGrid(T* obj, Cell const& cell)
         grid->GetGridType(cell.CellX(), cell.CellY()).template AddWorldObject<T>(obj);
     else
         grid->GetGridType(cell.CellX(), cell.CellY()).template AddGridObject<T>(obj);
+
+    //npcbot
+    if (obj->isType(TYPEMASK_UNIT))
+        _botPerceptionCache->Invalidate(cell.GetCellCoord());
+    //end npcbot
 }
 
 template<>
@@ -333,6 +342,10 @@ void Map::AddToGrid(Creature* obj, Cell const& cell)
         grid->GetGridType(cell.CellX(), cell.CellY()).AddGridObject(obj);
 
     obj->SetCurrentCell(cell);
+
+    //npcbot
+    _botPerceptionCache->Invalidate(cell.GetCellCoord());
+    //end npcbot
 }
 
 template<>
@@ -720,7 +733,7 @@ bool Map::IsGridLoaded(GridCoord const& p) const
     return (getNGrid(p.x_coord, p.y_coord) && isGridObjectDataLoaded(p.x_coord, p.y_coord));
 }
 
-void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor)
+void Map::MarkNearbyCellsOf(WorldObject* obj)
 {
     // Check for valid position
     if (!obj->IsPositionValid())
@@ -729,26 +742,74 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
     // Update mobs/objects in ALL visible cells around object!
     CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), obj->GetGridActivationRange());
 
+    // groups and their bots usually stand in the same cells, their areas only need to be marked once
+    if (!_activeCellAreas.insert((uint64(area.low_bound.GetId()) << 32) | area.high_bound.GetId()).second)
+        return;
+
     for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
     {
         for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
         {
-            // marked cells are those that have been visited
-            // don't visit the same cell twice
+            // marked cells are those that will be visited, don't visit the same cell twice
             uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
             if (isCellMarked(cell_id))
                 continue;
 
             markCell(cell_id);
-            CellCoord pair(x, y);
-            Cell cell(pair);
-            cell.SetNoCreate();
-            Visit(cell, gridVisitor);
-            Visit(cell, worldVisitor);
+            _activeCells.emplace_back(x, y);
         }
     }
 }
 
+void Map::CollectPlayerUpdateSources(Player* player, std::vector<WorldObject*>& sources)
+{
+    sources.push_back(player);
+
+    // If player is using far sight or mind vision, visit that object too
+    if (WorldObject* viewPoint = player->GetViewpoint())
+        sources.push_back(viewPoint);
+
+    // Handle updates for creatures in combat with player and are more than 60 yards away
+    if (player->IsInCombat())
+    {
+        for (auto const& pair : player->GetCombatManager().GetPvECombatRefs())
+            if (Creature* unit = pair.second->GetOther(player)->ToCreature())
+                if (unit->GetMapId() == player->GetMapId() && !unit->IsWithinDistInMap(player, GetVisibilityRange(), false))
+                    sources.push_back(unit);
+    }
+
+    { // Update any creatures that own auras the player has applications of
+        std::unordered_set<Unit*> toVisit;
+        for (std::pair<uint32, AuraApplication*> pair : player->GetAppliedAuras())
+        {
+            if (Unit* caster = pair.second->GetBase()->GetCaster())
+                if (caster->GetTypeId() != TYPEID_PLAYER && !caster->IsWithinDistInMap(player, GetVisibilityRange(), false))
+                    toVisit.insert(caster);
+        }
+        sources.insert(sources.end(), toVisit.begin(), toVisit.end());
+    }
+
+    // Update player's summons (totems)
+    for (ObjectGuid const& summonGuid : player->m_SummonSlot)
+        if (summonGuid)
+            if (Creature* unit = GetCreature(summonGuid))
+                if (unit->GetMapId() == player->GetMapId() && !unit->IsWithinDistInMap(player, GetVisibilityRange(), false))
+                    sources.push_back(unit);
+}
+
+namespace
+{
+    // cells of the same grid are stored together in NGrid, visit them grid by grid
+    uint32 GetCellUpdateOrder(CellCoord const& cellCoord)
+    {
+        uint32 gridX = cellCoord.x_coord / MAX_NUMBER_OF_CELLS;
+        uint32 gridY = cellCoord.y_coord / MAX_NUMBER_OF_CELLS;
+        uint32 cellX = cellCoord.x_coord % MAX_NUMBER_OF_CELLS;
+        uint32 cellY = cellCoord.y_coord % MAX_NUMBER_OF_CELLS;
+        return ((gridX * MAX_NUMBER_OF_GRIDS + gridY) * MAX_NUMBER_OF_CELLS + cellX) * MAX_NUMBER_OF_CELLS + cellY;
+    }
+}
+
 void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
 {
     // Nothing to do if no change
@@ -790,13 +851,13 @@ void Map::Update(uint32 t_diff)
         _respawnCheckTimer -= t_diff;
 
     /// update active cells around players and active objects
-    resetMarkedCells();
+    // every activity source only marks its cells, all marked cells are then updated once in grid/cell order
+    for (CellCoord const& cellCoord : _activeCells)
+        unmarkCell(cellCoord.GetId());
+    _activeCells.clear();
+    _activeCellAreas.clear();
 
-    Trinity::ObjectUpdater updater(t_diff);
-    // for creature
-    TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
-    // for pets
-    TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+    std::vector<WorldObject*> updateSources;
 
     // the player iterator is stored in the map object
     // to make sure calls to Map::Remove don't invalidate it
@@ -810,62 +871,50 @@ void Map::Update(uint32 t_diff)
         // update players at tick
         player->Update(t_diff);
 
-        VisitNearbyCellsOf(player, grid_object_update, world_object_update);
-
-        // If player is using far sight or mind vision, visit that object too
-        if (WorldObject* viewPoint = player->GetViewpoint())
-            VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
-
-        // Handle updates for creatures in combat with player and are more than 60 yards away
-        if (player->IsInCombat())
-        {
-            std::vector<Unit*> toVisit;
-            for (auto const& pair : player->GetCombatManager().GetPvECombatRefs())
-                if (Creature* unit = pair.second->GetOther(player)->ToCreature())
-                    if (unit->GetMapId() == player->GetMapId() && !unit->IsWithinDistInMap(player, GetVisibilityRange(), false))
-                        toVisit.push_back(unit);
-            for (Unit* unit : toVisit)
-                VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
-        }
+        updateSources.clear();
+        CollectPlayerUpdateSources(player, updateSources);
+        for (WorldObject* source : updateSources)
+            MarkNearbyCellsOf(source);
+    }
 
-        { // Update any creatures that own auras the player has applications of
-            std::unordered_set<Unit*> toVisit;
-            for (std::pair<uint32, AuraApplication*> pair : player->GetAppliedAuras())
-            {
-                if (Unit* caster = pair.second->GetBase()->GetCaster())
-                    if (caster->GetTypeId() != TYPEID_PLAYER && !caster->IsWithinDistInMap(player, GetVisibilityRange(), false))
-                        toVisit.insert(caster);
-            }
-            for (Unit* unit : toVisit)
-                VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
-        }
+    // non-player active objects
+    for (WorldObject* obj : m_activeNonPlayers)
+        if (obj && obj->IsInWorld())
+            MarkNearbyCellsOf(obj);
 
-        { // Update player's summons
-            std::vector<Unit*> toVisit;
+    std::sort(_activeCells.begin(), _activeCells.end(), [](CellCoord const& left, CellCoord const& right)
+    {
+        return GetCellUpdateOrder(left) < GetCellUpdateOrder(right);
+    });
 
-            // Totems
-            for (ObjectGuid const& summonGuid : player->m_SummonSlot)
-                if (summonGuid)
-                    if (Creature* unit = GetCreature(summonGuid))
-                        if (unit->GetMapId() == player->GetMapId() && !unit->IsWithinDistInMap(player, GetVisibilityRange(), false))
-                            toVisit.push_back(unit);
+    //npcbot: units may not be deleted until remove list is processed so bots can share grid searches
+    _botPerceptionCache->Open();
+    //end npcbot
 
-            for (Unit* unit : toVisit)
-                VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
-        }
-    }
+    Trinity::ObjectUpdater updater(t_diff);
+    // for creature
+    TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+    // for pets
+    TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
-    // non-player active objects, increasing iterator in the loop in case of object removal
-    for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+    for (CellCoord const& cellCoord : _activeCells)
     {
-        WorldObject* obj = *m_activeNonPlayersIter;
-        ++m_activeNonPlayersIter;
+        Cell cell(cellCoord);
+        cell.SetNoCreate();
+        Visit(cell, grid_object_update);
+        Visit(cell, world_object_update);
+    }
 
-        if (!obj || !obj->IsInWorld())
-            continue;
+    TC_METRIC_VALUE("map_update_cells", uint64(_activeCells.size()),
+        TC_METRIC_TAG("map_id", std::to_string(GetId())),
+        TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
 
-        VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
-    }
+    //npcbot
+    TC_METRIC_VALUE("map_bot_perception_cell_visits_saved", uint64(_botPerceptionCache->GetCellVisitsSaved()),
+        TC_METRIC_TAG("map_id", std::to_string(GetId())),
+        TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+    _botPerceptionCache->Close();
+    //end npcbot
 
     for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
     {
@@ -927,6 +976,12 @@ struct ResetNotifier
     void Visit(PlayerMapType &m) { resetNotify<Player>(m);}
 };
 
+bool Map::IsRelocationNotifyDue(GridCoord const& p) const
+{
+    NGridType* grid = getNGrid(p.x_coord, p.y_coord);
+    return grid && grid->GetGridState() == GRID_STATE_ACTIVE && grid->getGridInfoRef()->getRelocationTimer().TPassed();
+}
+
 void Map::ProcessRelocationNotifies(const uint32 diff)
 {
     for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end(); ++i)
@@ -1107,7 +1162,9 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
     }
 
     player->UpdatePositionData();
-    player->UpdateObjectVisibility(false);
+
+    // only moved, the relocation pass re-checks the objects near the edge of the visibility range
+    player->AddToNotify(NOTIFY_VISIBILITY_CHANGED);
 }
 
 void Map::CreatureRelocation(Creature* creature, float x, float y, float z, float ang, bool respawnRelocationOnFail)
@@ -39,6 +39,7 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <unordered_set>
 
 class Battleground;
 class BattlegroundMap;
@@ -56,6 +57,9 @@ class Transport;
 class Unit;
 class Weather;
 class WorldObject;
+//npcbot
+class BotPerceptionCache;
+//end npcbot
 class WorldPacket;
 struct MapDifficulty;
 struct MapEntry;
@@ -66,7 +70,6 @@ struct SummonPropertiesEntry;
 enum Difficulty : uint8;
 enum WeatherState : uint32;
 
-namespace Trinity { struct ObjectUpdater; }
 namespace VMAP { enum class ModelIgnoreFlags : uint32; }
 namespace G3D { class Plane; }
 
@@ -347,7 +350,6 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         template<class T> bool AddToMap(T *);
         template<class T> void RemoveFromMap(T *, bool);
 
-        void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(uint32);
 
         float GetVisibilityRange() const { return m_VisibleDistance; }
@@ -373,6 +375,9 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         bool IsGridLoaded(float x, float y) const { return IsGridLoaded(Trinity::ComputeGridCoord(x, y)); }
         bool IsGridLoaded(Position const& pos) const { return IsGridLoaded(pos.GetPositionX(), pos.GetPositionY()); }
 
+        // true if relocation notifies of the grid are processed in the current ProcessRelocationNotifies() call
+        bool IsRelocationNotifyDue(GridCoord const& p) const;
+
         bool GetUnloadLock(GridCoord const& p) const { return getNGrid(p.x_coord, p.y_coord)->getUnloadLock(); }
         void SetUnloadLock(GridCoord const& p, bool on) { getNGrid(p.x_coord, p.y_coord)->setUnloadExplicitLock(on); }
         void LoadGrid(float x, float y);
@@ -468,9 +473,9 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void AddObjectToSwitchList(WorldObject* obj, bool on);
         virtual void DelayedUpdate(uint32 diff);
 
-        void resetMarkedCells() { marked_cells.reset(); }
         bool isCellMarked(uint32 pCellId) { return marked_cells.test(pCellId); }
         void markCell(uint32 pCellId) { marked_cells.set(pCellId); }
+        void unmarkCell(uint32 pCellId) { marked_cells.reset(pCellId); }
 
         bool HavePlayers() const { return !m_mapRefManager.isEmpty(); }
         uint32 GetPlayersCountExceptGMs() const;
@@ -596,6 +601,13 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         time_t GetGORespawnTime(ObjectGuid::LowType spawnId) const { return GetRespawnTime(SPAWN_TYPE_GAMEOBJECT, spawnId); }
 
         void UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone);
+        //npcbot
+        uint32 GetZonePlayerCount(uint32 zoneId) const
+        {
+            auto const it = _zonePlayerCountMap.find(zoneId);
+            return it != _zonePlayerCountMap.end() ? it->second : 0;
+        }
+        //end npcbot
 
         void SaveRespawnTime(SpawnObjectType type, ObjectGuid::LowType spawnId, uint32 entry, time_t respawnTime, uint32 gridId, CharacterDatabaseTransaction dbTrans = nullptr, bool startup = false);
         void SaveRespawnInfoDB(RespawnInfo const& info, CharacterDatabaseTransaction dbTrans = nullptr);
@@ -654,6 +666,10 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         virtual std::string GetDebugInfo() const;
 
+        //npcbot
+        BotPerceptionCache* GetBotPerceptionCache() const { return _botPerceptionCache.get(); }
+        //end npcbot
+
     private:
         void LoadMapAndVMap(int gx, int gy);
         void LoadVMap(int gx, int gy);
@@ -708,6 +724,18 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         void SendObjectUpdates();
 
+        // objects around which cells are updated this tick
+        void CollectPlayerUpdateSources(Player* player, std::vector<WorldObject*>& sources);
+        void MarkNearbyCellsOf(WorldObject* obj);
+
+        // cells updated this tick, filled once from all activity sources
+        std::vector<CellCoord> _activeCells;
+        std::unordered_set<uint64> _activeCellAreas;
+
+        //npcbot
+        std::unique_ptr<BotPerceptionCache> _botPerceptionCache;
+        //end npcbot
+
     protected:
         void SetUnloadReferenceLock(GridCoord const& p, bool on) { getNGrid(p.x_coord, p.y_coord)->setUnloadReferenceLock(on); }
 
@@ -728,7 +756,6 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         typedef std::set<WorldObject*> ActiveNonPlayers;
         ActiveNonPlayers m_activeNonPlayers;
-        ActiveNonPlayers::iterator m_activeNonPlayersIter;
 
         // Objects that must update even in inactive grids without activating them
         typedef std::set<Transport*> TransportsContainer;
@@ -838,18 +865,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         void RemoveFromActiveHelper(WorldObject* obj)
         {
-            // Map::Update for active object in proccess
-            if (m_activeNonPlayersIter != m_activeNonPlayers.end())
-            {
-                ActiveNonPlayers::iterator itr = m_activeNonPlayers.find(obj);
-                if (itr == m_activeNonPlayers.end())
-                    return;
-                if (itr == m_activeNonPlayersIter)
-                    ++m_activeNonPlayersIter;
-                m_activeNonPlayers.erase(itr);
-            }
-            else
-                m_activeNonPlayers.erase(obj);
+            m_activeNonPlayers.erase(obj);
         }
 
         RespawnListContainer _respawnTimes;
@@ -33,12 +33,14 @@
 #include "Player.h"
 #include "WorldSession.h"
 #include "Opcodes.h"
+#include "PathfindingWorkerPool.h"
 #ifdef ELUNA
 #include "LuaEngine.h"
 #endif
 
 //npcbot
 #include "botmgr.h"
+#include "botdatamgr.h"
 //end npcbot
 
 MapManager::MapManager()
@@ -68,6 +70,9 @@ void MapManager::Initialize()
     if (num_threads > 0)
         m_updater.activate(num_threads);
 
+    if (sWorld->getBoolConfig(CONFIG_ENABLE_MMAPS) && sWorld->getIntConfig(CONFIG_MMAP_ASYNC_THREADS) > 0)
+        sPathfindingWorkerPool->Activate(sWorld->getIntConfig(CONFIG_MMAP_ASYNC_THREADS));
+
     //npcbot: load bots
     BotMgr::Initialize();
     //end npcbot
@@ -246,6 +251,10 @@ void MapManager::Update(uint32 diff)
     for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->DelayedUpdate(uint32(i_timer.GetCurrent()));
 
+    //npcbot: save pending bot data changes
+    BotDataMgr::UpdateNpcBotDataJournal(uint32(i_timer.GetCurrent()));
+    //end npcbot
+
     i_timer.SetCurrent(0);
 }
 
@@ -282,9 +291,15 @@ void MapManager::UnloadAll()
         i_maps.erase(iter++);
     }
 
+    //npcbot: save pending bot data changes and wait for queued statements before DB connections are closed
+    BotDataMgr::FlushNpcBotDataJournal(true);
+    //end npcbot
+
     if (m_updater.activated())
         m_updater.deactivate();
 
+    sPathfindingWorkerPool->Deactivate();
+
     Map::DeleteStateMachine();
 }
 
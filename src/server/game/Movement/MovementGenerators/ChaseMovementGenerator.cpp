@@ -107,6 +107,8 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
     {
         owner->StopMoving();
         _lastTargetPosition.reset();
+        if (_path)
+            _path->CancelAsyncPath();
         if (Creature* cOwner = owner->ToCreature())
             cOwner->SetCannotReachTarget(false);
         return true;
@@ -142,7 +144,9 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
     if (owner->HasUnitState(UNIT_STATE_CHASE_MOVE) && owner->movespline->Finalized())
     {
         RemoveFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
-        _path = nullptr;
+        // keep the path still being built, it is launched below
+        if (!_path || !_path->IsPathPending())
+            _path = nullptr;
         if (Creature* cOwner = owner->ToCreature())
             cOwner->SetCannotReachTarget(false);
         owner->ClearUnitState(UNIT_STATE_CHASE_MOVE);
@@ -150,6 +154,14 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
         DoMovementInform(owner, target);
     }
 
+    // path requested on a previous tick, move as soon as it is built
+    if (_path && _path->IsPathPending())
+    {
+        if (_path->ConsumeAsyncPath())
+            LaunchMovement(owner, target, true, _shortenPath, maxTarget);
+        return true;
+    }
+
     // if the target moved, we have to consider whether to adjust
     if (!_lastTargetPosition || target->GetPosition() != _lastTargetPosition.value() || mutualChase != _mutualChase)
     {
@@ -193,50 +205,64 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
             if (owner->IsHovering())
                 owner->UpdateAllowedPositionZ(x, y, z);
 
-            bool success = _path->CalculatePath(x, y, z, owner->CanFly());
-            if (!success || (_path->GetPathType() & (PATHFIND_NOPATH /* | PATHFIND_INCOMPLETE*/)))
+            if (_path->CalculatePathAsync(x, y, z, owner->CanFly()))
             {
-                if (cOwner)
-                    cOwner->SetCannotReachTarget(true);
-                owner->StopMoving();
+                _shortenPath = shortenPath;
+                if (_path->ConsumeAsyncPath())
+                    LaunchMovement(owner, target, true, shortenPath, maxTarget);
                 return true;
             }
 
-            if (shortenPath)
-                _path->ShortenPathUntilDist(PositionToVector3(target), maxTarget);
+            bool success = _path->CalculatePath(x, y, z, owner->CanFly());
+            LaunchMovement(owner, target, success, shortenPath, maxTarget);
+        }
+    }
 
-            if (cOwner)
-                cOwner->SetCannotReachTarget(false);
+    // and then, finally, we're done for the tick
+    return true;
+}
 
-            bool walk = false;
-            if (cOwner && !cOwner->IsPet())
-            {
-                switch (cOwner->GetMovementTemplate().GetChase())
-                {
-                    case CreatureChaseMovementType::CanWalk:
-                        walk = owner->IsWalking();
-                        break;
-                    case CreatureChaseMovementType::AlwaysWalk:
-                        walk = true;
-                        break;
-                    default:
-                        break;
-                }
-            }
+void ChaseMovementGenerator::LaunchMovement(Unit* owner, Unit* target, bool success, bool shortenPath, float maxTarget)
+{
+    Creature* const cOwner = owner->ToCreature();
+    if (!success || (_path->GetPathType() & (PATHFIND_NOPATH /* | PATHFIND_INCOMPLETE*/)))
+    {
+        if (cOwner)
+            cOwner->SetCannotReachTarget(true);
+        owner->StopMoving();
+        return;
+    }
 
-            owner->AddUnitState(UNIT_STATE_CHASE_MOVE);
-            AddFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
+    if (shortenPath)
+        _path->ShortenPathUntilDist(PositionToVector3(target), maxTarget);
 
-            Movement::MoveSplineInit init(owner);
-            init.MovebyPath(_path->GetPath());
-            init.SetWalk(walk);
-            init.SetFacing(target);
-            init.Launch();
+    if (cOwner)
+        cOwner->SetCannotReachTarget(false);
+
+    bool walk = false;
+    if (cOwner && !cOwner->IsPet())
+    {
+        switch (cOwner->GetMovementTemplate().GetChase())
+        {
+            case CreatureChaseMovementType::CanWalk:
+                walk = owner->IsWalking();
+                break;
+            case CreatureChaseMovementType::AlwaysWalk:
+                walk = true;
+                break;
+            default:
+                break;
         }
     }
 
-    // and then, finally, we're done for the tick
-    return true;
+    owner->AddUnitState(UNIT_STATE_CHASE_MOVE);
+    AddFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
+
+    Movement::MoveSplineInit init(owner);
+    init.MovebyPath(_path->GetPath());
+    init.SetWalk(walk);
+    init.SetFacing(target);
+    init.Launch();
 }
 
 void ChaseMovementGenerator::Deactivate(Unit* owner)
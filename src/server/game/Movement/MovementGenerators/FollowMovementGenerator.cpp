@@ -107,11 +107,21 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
     if (owner->HasUnitState(UNIT_STATE_FOLLOW_MOVE) && owner->movespline->Finalized())
     {
         RemoveFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
-        _path = nullptr;
+        // keep the path still being built, it is launched below
+        if (!_path || !_path->IsPathPending())
+            _path = nullptr;
         owner->ClearUnitState(UNIT_STATE_FOLLOW_MOVE);
         DoMovementInform(owner, target);
     }
 
+    // path requested on a previous tick, move as soon as it is built
+    if (_path && _path->IsPathPending())
+    {
+        if (_path->ConsumeAsyncPath())
+            LaunchMovement(owner, target, true);
+        return true;
+    }
+
     if (!_lastTargetPosition || _lastTargetPosition->GetExactDistSq(target->GetPosition()) > 0.0f)
     {
         _lastTargetPosition = target->GetPosition();
@@ -150,26 +160,38 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
                     allowShortcut = true;
             }
 
-            bool success = _path->CalculatePath(x, y, z, allowShortcut);
-            if (!success || (_path->GetPathType() & PATHFIND_NOPATH))
+            if (_path->CalculatePathAsync(x, y, z, allowShortcut))
             {
-                owner->StopMoving();
+                if (_path->ConsumeAsyncPath())
+                    LaunchMovement(owner, target, true);
                 return true;
             }
 
-            owner->AddUnitState(UNIT_STATE_FOLLOW_MOVE);
-            AddFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
-
-            Movement::MoveSplineInit init(owner);
-            init.MovebyPath(_path->GetPath());
-            init.SetWalk(target->IsWalking());
-            init.SetFacing(target->GetOrientation());
-            init.Launch();
+            bool success = _path->CalculatePath(x, y, z, allowShortcut);
+            LaunchMovement(owner, target, success);
         }
     }
     return true;
 }
 
+void FollowMovementGenerator::LaunchMovement(Unit* owner, Unit* target, bool success)
+{
+    if (!success || (_path->GetPathType() & PATHFIND_NOPATH))
+    {
+        owner->StopMoving();
+        return;
+    }
+
+    owner->AddUnitState(UNIT_STATE_FOLLOW_MOVE);
+    AddFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
+
+    Movement::MoveSplineInit init(owner);
+    init.MovebyPath(_path->GetPath());
+    init.SetWalk(target->IsWalking());
+    init.SetFacing(target->GetOrientation());
+    init.Launch();
+}
+
 void FollowMovementGenerator::Deactivate(Unit* owner)
 {
     AddFlag(MOVEMENTGENERATOR_FLAG_DEACTIVATED);
@@ -23,6 +23,7 @@
 #include "MovementDefines.h"
 #include "MoveSpline.h"
 #include "MoveSplineInit.h"
+#include "PathGenerator.h"
 #include "World.h"
 
 //----- Point Movement Generator
@@ -36,6 +37,9 @@ PointMovementGenerator<T>::PointMovementGenerator(uint32 id, float x, float y, f
     this->BaseUnitState = UNIT_STATE_ROAMING;
 }
 
+template<class T>
+PointMovementGenerator<T>::~PointMovementGenerator() { }
+
 template<class T>
 MovementGeneratorType PointMovementGenerator<T>::GetMovementGeneratorType() const
 {
@@ -63,19 +67,17 @@ void PointMovementGenerator<T>::DoInitialize(T* owner)
 
     owner->AddUnitState(UNIT_STATE_ROAMING_MOVE);
 
-    Movement::MoveSplineInit init(owner);
-    init.MoveTo(_x, _y, _z , _generatePath);
-    if (_speed > 0.0f)
-        init.SetVelocity(_speed);
-
-    if (_finalOrient)
-        init.SetFacing(*_finalOrient);
-
-    init.Launch();
+    // let pathfinding workers build the path, movement is launched from DoUpdate() once it is ready
+    if (_generatePath)
+    {
+        _path = std::make_unique<PathGenerator>(owner);
+        if (!_path->CalculatePathAsync(_x, _y, _z))
+            _path = nullptr;
+        else if (!_path->ConsumeAsyncPath())
+            return;
+    }
 
-    // Call for creature group update
-    if (Creature* creature = owner->ToCreature())
-        creature->SignalFormationMovement();
+    LaunchMovement(owner);
 }
 
 template<class T>
@@ -105,10 +107,18 @@ bool PointMovementGenerator<T>::DoUpdate(T* owner, uint32 /*diff*/)
     if (owner->HasUnitState(UNIT_STATE_NOT_MOVE) || owner->IsMovementPreventedByCasting())
     {
         MovementGenerator::AddFlag(MOVEMENTGENERATOR_FLAG_INTERRUPTED);
+        _path = nullptr;
         owner->StopMoving();
         return true;
     }
 
+    if (_path)
+    {
+        if (_path->ConsumeAsyncPath())
+            LaunchMovement(owner);
+        return true;
+    }
+
     if ((MovementGenerator::HasFlag(MOVEMENTGENERATOR_FLAG_INTERRUPTED) && owner->movespline->Finalized()) || (MovementGenerator::HasFlag(MOVEMENTGENERATOR_FLAG_SPEED_UPDATE_PENDING) && !owner->movespline->Finalized()))
     {
         MovementGenerator::RemoveFlag(MOVEMENTGENERATOR_FLAG_INTERRUPTED | MOVEMENTGENERATOR_FLAG_SPEED_UPDATE_PENDING);
@@ -140,6 +150,7 @@ void PointMovementGenerator<T>::DoDeactivate(T* owner)
 {
     MovementGenerator::AddFlag(MOVEMENTGENERATOR_FLAG_DEACTIVATED);
     owner->ClearUnitState(UNIT_STATE_ROAMING_MOVE);
+    _path = nullptr;
 }
 
 template<class T>
@@ -153,6 +164,35 @@ void PointMovementGenerator<T>::DoFinalize(T* owner, bool active, bool movementI
         MovementInform(owner);
 }
 
+template<class T>
+void PointMovementGenerator<T>::LaunchMovement(T* owner)
+{
+    Movement::MoveSplineInit init(owner);
+    if (_path)
+    {
+        // same as MoveSplineInit::MoveTo() with generatePath set
+        if (!(_path->GetPathType() & PATHFIND_NOPATH))
+            init.MovebyPath(_path->GetPath());
+        else
+            init.MoveTo(_x, _y, _z, false);
+        _path = nullptr;
+    }
+    else
+        init.MoveTo(_x, _y, _z , _generatePath);
+
+    if (_speed > 0.0f)
+        init.SetVelocity(_speed);
+
+    if (_finalOrient)
+        init.SetFacing(*_finalOrient);
+
+    init.Launch();
+
+    // Call for creature group update
+    if (Creature* creature = owner->ToCreature())
+        creature->SignalFormationMovement();
+}
+
 template<class T>
 void PointMovementGenerator<T>::MovementInform(T*) { }
 
@@ -165,6 +205,8 @@ void PointMovementGenerator<Creature>::MovementInform(Creature* owner)
 
 template PointMovementGenerator<Player>::PointMovementGenerator(uint32, float, float, float, bool, float, Optional<float>);
 template PointMovementGenerator<Creature>::PointMovementGenerator(uint32, float, float, float, bool, float, Optional<float>);
+template PointMovementGenerator<Player>::~PointMovementGenerator();
+template PointMovementGenerator<Creature>::~PointMovementGenerator();
 template MovementGeneratorType PointMovementGenerator<Player>::GetMovementGeneratorType() const;
 template MovementGeneratorType PointMovementGenerator<Creature>::GetMovementGeneratorType() const;
 template void PointMovementGenerator<Player>::DoInitialize(Player*);
@@ -20,14 +20,17 @@
 
 #include "MovementGenerator.h"
 #include "Optional.h"
+#include <memory>
 
 class Creature;
+class PathGenerator;
 
 template<class T>
 class PointMovementGenerator : public MovementGeneratorMedium<T, PointMovementGenerator<T>>
 {
     public:
         explicit PointMovementGenerator(uint32 id, float x, float y, float z, bool generatePath, float speed = 0.0f, Optional<float> finalOrient = {});
+        ~PointMovementGenerator();
 
         MovementGeneratorType GetMovementGeneratorType() const override;
 
@@ -43,11 +46,14 @@ class PointMovementGenerator : public MovementGeneratorMedium<T, PointMovementGe
 
     private:
         void MovementInform(T*);
+        void LaunchMovement(T*);
 
         uint32 _movementId;
         float _x, _y, _z;
         float _speed;
         bool _generatePath;
+        //! path being built by pathfinding workers, movement is launched once it is ready
+        std::unique_ptr<PathGenerator> _path;
         //! if set then unit will turn to specified _orient in provided _pos
         Optional<float> _finalOrient;
 };
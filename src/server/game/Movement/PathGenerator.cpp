@@ -25,13 +25,14 @@
 #include "DetourCommon.h"
 #include "DetourNavMeshQuery.h"
 #include "Metric.h"
+#include "PathfindingWorkerPool.h"
 
 ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(WorldObject const* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false),
     _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _useRaycast(false),
     _endPosition(G3D::Vector3::zero()), _source(owner), _navMesh(nullptr),
-    _navMeshQuery(nullptr)
+    _navMeshQuery(nullptr), _asyncState(PATH_ASYNC_IDLE)
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
@@ -48,12 +49,178 @@ PathGenerator::PathGenerator(WorldObject const* owner) :
     CreateFilter();
 }
 
+PathGenerator::PathGenerator(PathGenerator const& owner) :
+    _polyLength(owner._polyLength), _pathPoints(owner._pathPoints), _type(owner._type), _useStraightPath(owner._useStraightPath),
+    _forceDestination(owner._forceDestination), _pointPathLimit(owner._pointPathLimit), _useRaycast(owner._useRaycast),
+    _startPosition(owner._startPosition), _endPosition(owner._endPosition), _actualEndPosition(owner._actualEndPosition),
+    _source(owner._source), _navMesh(owner._navMesh), _navMeshQuery(owner._navMeshQuery), _filter(owner._filter),
+    _asyncSourceState(owner._asyncSourceState), _asyncState(PATH_ASYNC_PENDING)
+{
+    memcpy(_pathPolyRefs, owner._pathPolyRefs, sizeof(_pathPolyRefs));
+}
+
 PathGenerator::~PathGenerator()
 {
-    TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::~PathGenerator() for %s", _source->GetGUID().ToString().c_str());
+    CancelAsyncPath();
+
+    // requests may be destroyed by a worker thread
+    TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::~PathGenerator() for %s", GetSourceGUID().ToString().c_str());
 }
 
 bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool forceDest)
+{
+    CancelAsyncPath();
+
+    if (!PrepareCalculation(destX, destY, destZ, forceDest))
+        return false;
+
+    TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::CalculatePath() for %s", _source->GetGUID().ToString().c_str());
+
+    // make sure navMesh works - we can run on map w/o mmap
+    // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
+    if (!CanUseNavMesh())
+    {
+        BuildShortcut();
+        _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+        return true;
+    }
+
+    UpdateFilter();
+
+    BuildPolyPath(_startPosition, _endPosition);
+    return true;
+}
+
+bool PathGenerator::CalculatePathAsync(float destX, float destY, float destZ, bool forceDest)
+{
+    if (!sPathfindingWorkerPool->IsActive())
+        return false;
+
+    if (_source->GetExactDistSq(destX, destY, destZ) < MIN_ASYNC_PATH_DISTANCE * MIN_ASYNC_PATH_DISTANCE)
+        return false;
+
+    CancelAsyncPath();
+
+    if (!PrepareCalculation(destX, destY, destZ, forceDest))
+        return false;
+
+    TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::CalculatePathAsync() for %s", _source->GetGUID().ToString().c_str());
+
+    // nothing to build, result is ready right away
+    if (!CanUseNavMesh())
+    {
+        BuildShortcut();
+        _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+        _asyncState.store(PATH_ASYNC_READY, std::memory_order_release);
+        return true;
+    }
+
+    UpdateFilter();
+    CaptureSourceState();
+
+    _asyncRequest.reset(new PathGenerator(*this));
+    _asyncSourceState.reset();
+    _asyncState.store(PATH_ASYNC_PENDING, std::memory_order_release);
+    sPathfindingWorkerPool->Enqueue(_asyncRequest);
+    return true;
+}
+
+bool PathGenerator::ConsumeAsyncPath()
+{
+    switch (_asyncState.load(std::memory_order_acquire))
+    {
+        case PATH_ASYNC_PENDING:
+            if (_asyncRequest->_asyncState.load(std::memory_order_acquire) != PATH_ASYNC_READY)
+                return false;
+            TakeAsyncResult(*_asyncRequest);
+            _asyncRequest.reset();
+            break;
+        case PATH_ASYNC_READY:
+            break;
+        default:
+            return false;
+    }
+
+    if (_asyncSourceState)
+    {
+        bool normalize = _asyncSourceState->NormalizePending;
+        bool normalizeActualEnd = _asyncSourceState->NormalizeActualEnd;
+        _asyncSourceState.reset();
+
+        // back on map thread, source can be accessed again
+        if (normalize)
+        {
+            NormalizePath();
+            if (normalizeActualEnd && !_pathPoints.empty())
+                SetActualEndPosition(_pathPoints.back());
+        }
+    }
+
+    _asyncState.store(PATH_ASYNC_IDLE, std::memory_order_release);
+    return true;
+}
+
+void PathGenerator::CancelAsyncPath()
+{
+    if (_asyncState.load(std::memory_order_acquire) == PATH_ASYNC_IDLE)
+        return;
+
+    // the worker holds its own reference, the result is discarded together with the request
+    _asyncRequest.reset();
+    _asyncSourceState.reset();
+    _asyncState.store(PATH_ASYNC_IDLE, std::memory_order_release);
+}
+
+void PathGenerator::TakeAsyncResult(PathGenerator& request)
+{
+    memcpy(_pathPolyRefs, request._pathPolyRefs, sizeof(_pathPolyRefs));
+    _polyLength = request._polyLength;
+    _pathPoints = std::move(request._pathPoints);
+    _type = request._type;
+    _startPosition = request._startPosition;
+    _endPosition = request._endPosition;
+    _actualEndPosition = request._actualEndPosition;
+    _asyncSourceState = request._asyncSourceState;
+}
+
+ObjectGuid PathGenerator::GetSourceGUID() const
+{
+    return _asyncSourceState ? _asyncSourceState->Guid : _source->GetGUID();
+}
+
+std::string PathGenerator::GetSourceDebugInfo() const
+{
+    return _asyncSourceState ? _asyncSourceState->Guid.ToString() : _source->GetDebugInfo();
+}
+
+void PathGenerator::BuildPathAsync()
+{
+    TC_METRIC_DETAILED_EVENT("mmap_events", "BuildPathAsync", "");
+
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+
+    // navmesh query is not thread safe, use one owned by this worker thread
+    // tiles cannot be added or removed while the lock is held
+    {
+        std::shared_lock<std::shared_mutex> lock = mmap->LockNavMesh(_asyncSourceState->MapId);
+        dtNavMeshQuery const* mapQuery = _navMeshQuery;
+        _navMeshQuery = lock.owns_lock() ? mmap->GetThreadNavMeshQuery(_asyncSourceState->MapId) : nullptr;
+
+        if (_navMeshQuery)
+            BuildPolyPath(_startPosition, _endPosition);
+        else
+        {
+            BuildShortcut();
+            _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+        }
+
+        _navMeshQuery = mapQuery;
+    }
+
+    _asyncState.store(PATH_ASYNC_READY, std::memory_order_release);
+}
+
+bool PathGenerator::PrepareCalculation(float destX, float destY, float destZ, bool forceDest)
 {
     float x, y, z;
     _source->GetPosition(x, y, z);
@@ -70,26 +237,83 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
     SetStartPosition(start);
 
     _forceDestination = forceDest;
+    return true;
+}
 
-    TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::CalculatePath() for %s", _source->GetGUID().ToString().c_str());
-
-    // make sure navMesh works - we can run on map w/o mmap
-    // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
+bool PathGenerator::CanUseNavMesh() const
+{
     Unit const* _sourceUnit = _source->ToUnit();
-    if (!_navMesh || !_navMeshQuery || (_sourceUnit && _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING)) ||
-        !HaveTile(start) || !HaveTile(dest))
+    return _navMesh && _navMeshQuery && !(_sourceUnit && _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING)) &&
+        HaveTile(_startPosition) && HaveTile(_endPosition);
+}
+
+void PathGenerator::CaptureSourceState()
+{
+    SourceState state;
+    Creature const* creature = _source->GetTypeId() == TYPEID_UNIT ? _source->ToCreature() : nullptr;
+    Unit const* unit = _source->ToUnit();
+    Map const* map = _source->GetMap();
+    uint32 phaseMask = _source->GetPhaseMask();
+
+    state.Guid = _source->GetGUID();
+    state.MapId = _source->GetMapId();
+    state.CreatureCanFly = creature && creature->CanFly();
+    state.CreatureCanSwim = creature && creature->CanSwim();
+    state.CanFly = unit && unit->CanFly();
+    state.CanSwim = unit && unit->CanSwim();
+    state.IsFalling = unit && unit->IsFalling();
+
+    // liquid checks are only needed by shortcut cases these flags allow
+    state.StartInWater = state.EndInWater = false;
+    if (state.CreatureCanSwim)
     {
-        BuildShortcut();
-        _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
-        return true;
+        float collisionHeight = _source->GetCollisionHeight();
+        state.StartInWater = map->GetLiquidStatus(phaseMask, _startPosition.x, _startPosition.y, _startPosition.z, MAP_ALL_LIQUIDS, nullptr, collisionHeight) != LIQUID_MAP_NO_WATER;
+        state.EndInWater = map->GetLiquidStatus(phaseMask, _endPosition.x, _endPosition.y, _endPosition.z, MAP_ALL_LIQUIDS, nullptr, collisionHeight) != LIQUID_MAP_NO_WATER;
     }
 
-    UpdateFilter();
+    state.StartUnderWater = state.EndUnderWater = false;
+    if (state.CanSwim || state.CanFly || state.IsFalling)
+    {
+        state.StartUnderWater = map->IsUnderWater(phaseMask, _startPosition.x, _startPosition.y, _startPosition.z);
+        state.EndUnderWater = map->IsUnderWater(phaseMask, _endPosition.x, _endPosition.y, _endPosition.z);
+    }
+
+    state.NormalizePending = false;
+    state.NormalizeActualEnd = false;
+
+    _asyncSourceState = state;
+}
+
+bool PathGenerator::IsWaterPath() const
+{
+    if (_asyncSourceState)
+        return _asyncSourceState->CreatureCanSwim && _asyncSourceState->StartInWater && _asyncSourceState->EndInWater;
+
+    if (_source->GetTypeId() != TYPEID_UNIT || !_source->ToCreature()->CanSwim())
+        return false;
+
+    // Check both start and end points, if they're both in water, then we can *safely* let the creature move
+    for (uint32 i = 0; i < _pathPoints.size(); ++i)
+    {
+        ZLiquidStatus status = _source->GetMap()->GetLiquidStatus(_source->GetPhaseMask(), _pathPoints[i].x, _pathPoints[i].y, _pathPoints[i].z, MAP_ALL_LIQUIDS, nullptr, _source->GetCollisionHeight());
+        // One of the points is not in the water, cancel movement.
+        if (status == LIQUID_MAP_NO_WATER)
+            return false;
+    }
 
-    BuildPolyPath(start, dest);
     return true;
 }
 
+bool PathGenerator::IsUnderWater(bool start) const
+{
+    if (_asyncSourceState)
+        return start ? _asyncSourceState->StartUnderWater : _asyncSourceState->EndUnderWater;
+
+    G3D::Vector3 const& p = start ? _startPosition : _endPosition;
+    return _source->GetMap()->IsUnderWater(_source->GetPhaseMask(), p.x, p.y, p.z);
+}
+
 dtPolyRef PathGenerator::GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* point, float* distance) const
 {
     if (!polyPath || !polyPathSize)
@@ -176,23 +400,9 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
     {
         TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: (startPoly == 0 || endPoly == 0)");
         BuildShortcut();
-        bool path = _source->GetTypeId() == TYPEID_UNIT && _source->ToCreature()->CanFly();
+        bool path = _asyncSourceState ? _asyncSourceState->CreatureCanFly : (_source->GetTypeId() == TYPEID_UNIT && _source->ToCreature()->CanFly());
 
-        bool waterPath = _source->GetTypeId() == TYPEID_UNIT && _source->ToCreature()->CanSwim();
-        if (waterPath)
-        {
-            // Check both start and end points, if they're both in water, then we can *safely* let the creature move
-            for (uint32 i = 0; i < _pathPoints.size(); ++i)
-            {
-                ZLiquidStatus status = _source->GetMap()->GetLiquidStatus(_source->GetPhaseMask(), _pathPoints[i].x, _pathPoints[i].y, _pathPoints[i].z, MAP_ALL_LIQUIDS, nullptr, _source->GetCollisionHeight());
-                // One of the points is not in the water, cancel movement.
-                if (status == LIQUID_MAP_NO_WATER)
-                {
-                    waterPath = false;
-                    break;
-                }
-            }
-        }
+        bool waterPath = IsWaterPath();
 
         if (path || waterPath)
         {
@@ -217,25 +427,21 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
 
         bool buildShotrcut = false;
 
-        G3D::Vector3 const& p = (distToStartPoly > 7.0f) ? startPos : endPos;
-        if (_source->GetMap()->IsUnderWater(_source->GetPhaseMask(), p.x, p.y, p.z))
+        Unit const* _sourceUnit = _source->ToUnit();
+        if (IsUnderWater(distToStartPoly > 7.0f))
         {
             TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: underWater case");
-            if (Unit const* _sourceUnit = _source->ToUnit())
-                if (_sourceUnit->CanSwim())
-                    buildShotrcut = true;
+            if (_asyncSourceState ? _asyncSourceState->CanSwim : (_sourceUnit && _sourceUnit->CanSwim()))
+                buildShotrcut = true;
         }
         else
         {
             TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: flying case");
-            if (Unit const* _sourceUnit = _source->ToUnit())
-            {
-                if (_sourceUnit->CanFly())
-                    buildShotrcut = true;
-                // Allow to build a shortcut if the unit is falling and it's trying to move downwards towards a target (i.e. charging)
-                else if (_sourceUnit->IsFalling() && endPos.z < startPos.z)
-                    buildShotrcut = true;
-            }
+            if (_asyncSourceState ? _asyncSourceState->CanFly : (_sourceUnit && _sourceUnit->CanFly()))
+                buildShotrcut = true;
+            // Allow to build a shortcut if the unit is falling and it's trying to move downwards towards a target (i.e. charging)
+            else if ((_asyncSourceState ? _asyncSourceState->IsFalling : (_sourceUnit && _sourceUnit->IsFalling())) && endPos.z < startPos.z)
+                buildShotrcut = true;
         }
 
         if (buildShotrcut)
@@ -304,7 +510,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
                 TC_LOG_ERROR("maps.mmaps", "Invalid poly ref in BuildPolyPath. _polyLength: %u, pathStartIndex: %u,"
                                      " startPos: %s, endPos: %s, mapid: %u",
                                      _polyLength, pathStartIndex, startPos.toString().c_str(), endPos.toString().c_str(),
-                                     _source->GetMapId());
+                                     _asyncSourceState ? _asyncSourceState->MapId : _source->GetMapId());
 
                 break;
             }
@@ -379,21 +585,20 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         dtStatus dtResult;
         if (_useRaycast)
         {
-            TC_LOG_ERROR("maps.mmaps", "PathGenerator::BuildPolyPath() called with _useRaycast with a previous path for unit %s", _source->GetGUID().ToString().c_str());
+            TC_LOG_ERROR("maps.mmaps", "PathGenerator::BuildPolyPath() called with _useRaycast with a previous path for unit %s", GetSourceGUID().ToString().c_str());
             BuildShortcut();
             _type = PATHFIND_NOPATH;
             return;
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
+            dtResult = FindPolyPath(
                             suffixStartPoly,    // start polygon
                             endPoly,            // end polygon
                             suffixEndPoint,     // start position
                             endPoint,           // end position
-                            &_filter,            // polygon search filter
                             _pathPolyRefs + prefixPolyLength - 1,    // [out] path
-                            (int*)&suffixPolyLength,
+                            suffixPolyLength,
                             MAX_PATH_LENGTH - prefixPolyLength);   // max number of polygons in output path
         }
 
@@ -402,7 +607,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
             // this is probably an error state, but we'll leave it
             // and hopefully recover on the next Update
             // we still need to copy our preffix
-            TC_LOG_ERROR("maps.mmaps", "Path Build failed\n%s", _source->GetDebugInfo().c_str());
+            TC_LOG_ERROR("maps.mmaps", "Path Build failed\n%s", GetSourceDebugInfo().c_str());
         }
 
         TC_LOG_DEBUG("maps.mmaps", "++  m_polyLength=%u prefixPolyLength=%u suffixPolyLength=%u", _polyLength, prefixPolyLength, suffixPolyLength);
@@ -493,21 +698,20 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
+            dtResult = FindPolyPath(
                             startPoly,          // start polygon
                             endPoly,            // end polygon
                             startPoint,         // start position
                             endPoint,           // end position
-                            &_filter,           // polygon search filter
                             _pathPolyRefs,     // [out] path
-                            (int*)&_polyLength,
+                            _polyLength,
                             MAX_PATH_LENGTH);   // max number of polygons in output path
         }
 
         if (!_polyLength || dtStatusFailed(dtResult))
         {
             // only happens if we passed bad data to findPath(), or navmesh is messed up
-            TC_LOG_ERROR("maps.mmaps", "%s Path Build failed: 0 length path", _source->GetGUID().ToString().c_str());
+            TC_LOG_ERROR("maps.mmaps", "%s Path Build failed: 0 length path", GetSourceGUID().ToString().c_str());
             BuildShortcut();
             _type = PATHFIND_NOPATH;
             return;
@@ -526,6 +730,26 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
     BuildPointPath(startPoint, endPoint);
 }
 
+dtStatus PathGenerator::FindPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, float const* startPoint, float const* endPoint, dtPolyRef* path, uint32& pathSize, uint32 maxPathSize)
+{
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+    MMAP::PolyPathCacheKey key = { startPoly, endPoly, _filter.getIncludeFlags(), _filter.getExcludeFlags() };
+    uint32 mapId = _asyncSourceState ? _asyncSourceState->MapId : _source->GetMapId();
+
+    if (mmap->GetCachedPolyPath(mapId, key, path, pathSize, maxPathSize))
+        return DT_SUCCESS;
+
+    int polyCount = 0;
+    dtStatus dtResult = _navMeshQuery->findPath(startPoly, endPoly, startPoint, endPoint, &_filter, path, &polyCount, maxPathSize);
+    pathSize = uint32(polyCount);
+
+    // partial corridors depend on search limits, only share complete ones
+    if (pathSize && dtStatusSucceed(dtResult) && !dtStatusDetail(dtResult, DT_PARTIAL_RESULT))
+        mmap->CachePolyPath(mapId, key, path, pathSize);
+
+    return dtResult;
+}
+
 void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoint)
 {
     float pathPoints[MAX_POINT_PATH_LENGTH*VERTEX_SIZE];
@@ -534,7 +758,7 @@ void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoin
     if (_useRaycast)
     {
         // _straightLine uses raycast and it currently doesn't support building a point path, only a 2-point path with start and hitpoint/end is returned
-        TC_LOG_ERROR("maps.mmaps", "PathGenerator::BuildPointPath() called with _useRaycast for unit %s", _source->GetGUID().ToString().c_str());
+        TC_LOG_ERROR("maps.mmaps", "PathGenerator::BuildPointPath() called with _useRaycast for unit %s", GetSourceGUID().ToString().c_str());
         BuildShortcut();
         _type = PATHFIND_NOPATH;
         return;
@@ -597,6 +821,8 @@ void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoin
 
     // first point is always our current location - we need the next one
     SetActualEndPosition(_pathPoints[pointCount-1]);
+    if (_asyncSourceState)
+        _asyncSourceState->NormalizeActualEnd = true;
 
     // force the given destination, if needed
     if (_forceDestination &&
@@ -614,6 +840,9 @@ void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoin
             BuildShortcut();
         }
 
+        if (_asyncSourceState)
+            _asyncSourceState->NormalizeActualEnd = false;
+
         _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
     }
 
@@ -622,6 +851,13 @@ void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoin
 
 void PathGenerator::NormalizePath()
 {
+    // source cannot be accessed from pathfinding worker threads
+    if (_asyncSourceState)
+    {
+        _asyncSourceState->NormalizePending = true;
+        return;
+    }
+
     for (uint32 i = 0; i < _pathPoints.size(); ++i)
         _source->UpdateAllowedPositionZ(_pathPoints[i].x, _pathPoints[i].y, _pathPoints[i].z);
 }
@@ -882,7 +1118,7 @@ dtStatus PathGenerator::FindSmoothPath(float const* startPos, float const* endPo
         npolys = FixupCorridor(polys, npolys, MAX_PATH_LENGTH, visited, nvisited);
 
         if (dtStatusFailed(_navMeshQuery->getPolyHeight(polys[0], result, &result[1])))
-            TC_LOG_DEBUG("maps.mmaps", "Cannot find height at position X: %f Y: %f Z: %f for %s", result[2], result[0], result[1], _source->GetDebugInfo().c_str());
+            TC_LOG_DEBUG("maps.mmaps", "Cannot find height at position X: %f Y: %f Z: %f for %s", result[2], result[0], result[1], GetSourceDebugInfo().c_str());
         result[1] += 0.5f;
         dtVcopy(iterPos, result);
 
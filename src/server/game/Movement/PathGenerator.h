@@ -22,7 +22,11 @@
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
 #include "MoveSplineInitArgs.h"
+#include "ObjectGuid.h"
+#include "Optional.h"
 #include <G3D/Vector3.h>
+#include <atomic>
+#include <memory>
 
 class Unit;
 class WorldObject;
@@ -36,6 +40,9 @@ class WorldObject;
 #define SMOOTH_PATH_STEP_SIZE   4.0f
 #define SMOOTH_PATH_SLOP        0.3f
 
+// paths to closer destinations are cheap to build, waiting a tick for a worker would only delay the movement
+#define MIN_ASYNC_PATH_DISTANCE 15.0f
+
 #define VERTEX_SIZE       3
 #define INVALID_POLYREF   0
 
@@ -62,6 +69,18 @@ class TC_GAME_API PathGenerator
         // Calculate the path from owner to given destination
         // return: true if new path was calculated, false otherwise (no change needed)
         bool CalculatePath(float destX, float destY, float destZ, bool forceDest = false);
+        // Same as CalculatePath() but the path is built by pathfinding worker threads, see PathfindingWorkerPool
+        // return: false if the path cannot be requested asynchronously or is too short to be worth it,
+        // CalculatePath() has to be used instead
+        bool CalculatePathAsync(float destX, float destY, float destZ, bool forceDest = false);
+        // true since CalculatePathAsync() until the result is consumed or canceled
+        bool IsPathPending() const { return _asyncState.load(std::memory_order_acquire) != PATH_ASYNC_IDLE; }
+        // return: true if requested path is built, result getters can be used from now on
+        bool ConsumeAsyncPath();
+        // never waits, a request already being built is finished by its worker and dropped
+        void CancelAsyncPath();
+        // called by pathfinding worker threads on the request created by CalculatePathAsync()
+        void BuildPathAsync();
         bool IsInvalidDestinationZ(Unit const* target) const;
 
         // option setters - use optional
@@ -82,6 +101,30 @@ class TC_GAME_API PathGenerator
         void ShortenPathUntilDist(G3D::Vector3 const& point, float dist);
 
     private:
+        enum PathAsyncState : uint8
+        {
+            PATH_ASYNC_IDLE,
+            PATH_ASYNC_PENDING,
+            PATH_ASYNC_READY
+        };
+
+        // state of the source captured by CalculatePathAsync(), worker threads must not access units or maps
+        struct SourceState
+        {
+            ObjectGuid Guid;
+            uint32 MapId;
+            bool CreatureCanFly;
+            bool CreatureCanSwim;
+            bool CanFly;
+            bool CanSwim;
+            bool IsFalling;
+            bool StartInWater;
+            bool EndInWater;
+            bool StartUnderWater;
+            bool EndUnderWater;
+            bool NormalizePending;      // NormalizePath() is deferred to ConsumeAsyncPath()
+            bool NormalizeActualEnd;    // actual end position has to follow the normalized last point
+        };
 
         dtPolyRef _pathPolyRefs[MAX_PATH_LENGTH];   // array of detour polygon references
         uint32 _polyLength;                         // number of polygons in the path
@@ -104,11 +147,27 @@ class TC_GAME_API PathGenerator
 
         dtQueryFilter _filter;  // use single filter for all movements, update it when needed
 
+        Optional<SourceState> _asyncSourceState;
+        std::atomic<uint8> _asyncState;
+        std::shared_ptr<PathGenerator> _asyncRequest;  // copy of this generator the path is built in, shared with the worker
+
+        // creates the request built by workers, owns everything BuildPolyPath() needs
+        PathGenerator(PathGenerator const& owner);
+        void TakeAsyncResult(PathGenerator& request);
+        ObjectGuid GetSourceGUID() const;
+        std::string GetSourceDebugInfo() const;
+
         void SetStartPosition(G3D::Vector3 const& point) { _startPosition = point; }
         void SetEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; _endPosition = point; }
         void SetActualEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; }
         void NormalizePath();
 
+        bool PrepareCalculation(float destX, float destY, float destZ, bool forceDest);
+        bool CanUseNavMesh() const;
+        void CaptureSourceState();
+        bool IsWaterPath() const;
+        bool IsUnderWater(bool start) const;
+
         void Clear()
         {
             _polyLength = 0;
@@ -124,6 +183,8 @@ class TC_GAME_API PathGenerator
         bool HaveTile(G3D::Vector3 const& p) const;
 
         void BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos);
+        // findPath() through the corridor cache of MMapManager
+        dtStatus FindPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, float const* startPoint, float const* endPoint, dtPolyRef* path, uint32& pathSize, uint32 maxPathSize);
         void BuildPointPath(float const* startPoint, float const* endPoint);
         void BuildShortcut();
 
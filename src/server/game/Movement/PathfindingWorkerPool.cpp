@@ -0,0 +1,88 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathfindingWorkerPool.h"
+#include "PathGenerator.h"
+
+PathfindingWorkerPool* PathfindingWorkerPool::instance()
+{
+    static PathfindingWorkerPool instance;
+    return &instance;
+}
+
+void PathfindingWorkerPool::Activate(size_t numThreads)
+{
+    _cancelationToken = false;
+    for (size_t i = 0; i < numThreads; ++i)
+        _workerThreads.push_back(std::thread(&PathfindingWorkerPool::WorkerThread, this));
+}
+
+void PathfindingWorkerPool::Deactivate()
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _cancelationToken = true;
+    }
+    _queueCondition.notify_all();
+
+    for (std::thread& thread : _workerThreads)
+        thread.join();
+
+    _workerThreads.clear();
+
+    // nobody is left to build queued paths, build them here so their owners are not left waiting
+    std::deque<std::shared_ptr<PathGenerator>> queue;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        queue.swap(_queue);
+    }
+    for (std::shared_ptr<PathGenerator> const& request : queue)
+        if (request.use_count() > 1)
+            request->BuildPathAsync();
+}
+
+void PathfindingWorkerPool::Enqueue(std::shared_ptr<PathGenerator> request)
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _queue.push_back(std::move(request));
+    }
+    _queueCondition.notify_one();
+}
+
+void PathfindingWorkerPool::WorkerThread()
+{
+    while (true)
+    {
+        std::shared_ptr<PathGenerator> request;
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            _queueCondition.wait(lock, [this]() { return _cancelationToken || !_queue.empty(); });
+            if (_cancelationToken)
+                return;
+
+            request = std::move(_queue.front());
+            _queue.pop_front();
+        }
+
+        // canceled or replaced by a newer request, nobody will read the result
+        if (request.use_count() == 1)
+            continue;
+
+        request->BuildPathAsync();
+    }
+}
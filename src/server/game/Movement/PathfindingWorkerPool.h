@@ -0,0 +1,59 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PATHFINDING_WORKER_POOL_H
+#define _PATHFINDING_WORKER_POOL_H
+
+#include "Define.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class PathGenerator;
+
+// Worker threads building paths requested with PathGenerator::CalculatePathAsync()
+// Requests are shared with the PathGenerator that created them, a request its owner dropped is stale and skipped
+class TC_GAME_API PathfindingWorkerPool
+{
+    public:
+        static PathfindingWorkerPool* instance();
+
+        void Activate(size_t numThreads);
+        void Deactivate();
+        bool IsActive() const { return !_workerThreads.empty(); }
+
+        void Enqueue(std::shared_ptr<PathGenerator> request);
+
+    private:
+        PathfindingWorkerPool() : _cancelationToken(false) { }
+        ~PathfindingWorkerPool() { Deactivate(); }
+
+        void WorkerThread();
+
+        std::deque<std::shared_ptr<PathGenerator>> _queue;
+        std::vector<std::thread> _workerThreads;
+        std::mutex _lock;
+        std::condition_variable _queueCondition;
+        bool _cancelationToken;
+};
+
+#define sPathfindingWorkerPool PathfindingWorkerPool::instance()
+
+#endif
@@ -18,7 +18,10 @@
 #ifndef __SERVERPKTHDR_H__
 #define __SERVERPKTHDR_H__
 
+#include "AuthCrypt.h"
 #include "Log.h"
+#include <utility>
+#include <vector>
 
 #pragma pack(push, 1)
 
@@ -59,4 +62,55 @@ struct ServerPktHeader
 
 #pragma pack(pop)
 
+/**
+ * Headers of packets sent together, laid out contiguously so the encrypted ones
+ * go through the cipher in one pass instead of one call per packet
+ */
+class ServerPktHeaderBatch
+{
+public:
+    void Clear()
+    {
+        _data.clear();
+        _offsets.clear();
+        _encryptedRanges.clear();
+    }
+
+    void Add(uint32 size, uint16 cmd, bool encrypt)
+    {
+        ServerPktHeader header(size, cmd);
+        uint32 offset = uint32(_data.size());
+        _data.insert(_data.end(), header.header, header.header + header.getHeaderLength());
+        _offsets.push_back(offset);
+
+        if (!encrypt)
+            return;
+
+        if (!_encryptedRanges.empty() && _encryptedRanges.back().second == offset)
+            _encryptedRanges.back().second = uint32(_data.size());
+        else
+            _encryptedRanges.emplace_back(offset, uint32(_data.size()));
+    }
+
+    // ARC4 is a stream cipher, encrypting consecutive headers at once gives the same output as encrypting them one by one
+    template<class Crypt = AuthCrypt>
+    void Encrypt(Crypt& crypt)
+    {
+        for (std::pair<uint32, uint32> const& range : _encryptedRanges)
+            crypt.EncryptSend(_data.data() + range.first, range.second - range.first);
+    }
+
+    std::size_t GetCount() const { return _offsets.size(); }
+    uint8 const* GetHeader(std::size_t index) const { return _data.data() + _offsets[index]; }
+    std::size_t GetHeaderLength(std::size_t index) const
+    {
+        return (index + 1 < _offsets.size() ? _offsets[index + 1] : _data.size()) - _offsets[index];
+    }
+
+private:
+    std::vector<uint8> _data;
+    std::vector<uint32> _offsets;
+    std::vector<std::pair<uint32, uint32>> _encryptedRanges;
+};
+
 #endif
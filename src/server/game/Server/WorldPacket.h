@@ -81,6 +81,7 @@ class WorldPacket : public ByteBuffer
         void SetOpcode(uint16 opcode) { m_opcode = opcode; }
 
         TimePoint GetReceivedTime() const { return m_receivedTime; }
+        void SetReceivedTime(TimePoint receivedTime) { m_receivedTime = receivedTime; }
 
     protected:
         uint16 m_opcode;
@@ -136,6 +136,7 @@ WorldSession::WorldSession(uint32 id, std::string&& name, std::shared_ptr<WorldS
     m_TutorialsChanged(TUTORIALS_FLAG_NONE),
     recruiterId(recruiter),
     isRecruiter(isARecruiter),
+    _recvPacketPoolSize(0),
     _RBACData(nullptr),
     expireTime(60000), // 1 min after socket loss, session is deleted
     forceExit(false),
@@ -179,7 +180,11 @@ WorldSession::~WorldSession()
 
     ///- empty incoming packet queue
     WorldPacket* packet = nullptr;
-    while (_recvQueue.next(packet))
+    for (WorldPacket* requeued : _requeuedPackets)
+        delete requeued;
+    while (_recvQueue.Dequeue(packet))
+        delete packet;
+    while (_recvPacketPool.Dequeue(packet))
         delete packet;
 
     LoginDatabase.PExecute("UPDATE account SET online = 0 WHERE id = %u;", GetAccountId());     // One-time query
@@ -265,7 +270,50 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
-    _recvQueue.add(new_packet);
+    _recvQueue.Enqueue(new_packet);
+}
+
+WorldPacket* WorldSession::AcquireRecvPacket()
+{
+    WorldPacket* packet = nullptr;
+    if (_recvPacketPool.Dequeue(packet))
+    {
+        --_recvPacketPoolSize;
+        return packet;
+    }
+
+    return new WorldPacket();
+}
+
+/// Gets the next packet to process, packets requeued by previous updates were received before anything still in _recvQueue
+bool WorldSession::NextRecvPacket(WorldPacket*& packet, PacketFilter& updater)
+{
+    bool const requeued = !_requeuedPackets.empty();
+    WorldPacket** front = requeued ? &_requeuedPackets.front() : _recvQueue.Peek();
+    if (!front || !updater.Process(*front))
+        return false;
+
+    packet = *front;
+    if (requeued)
+        _requeuedPackets.pop_front();
+    else
+        _recvQueue.Pop();
+    return true;
+}
+
+void WorldSession::ReleaseRecvPacket(WorldPacket* packet)
+{
+    // enough to cover bursts, the rest is freed
+    constexpr uint32 MAX_POOLED_RECV_PACKETS = 32;
+
+    if (_recvPacketPoolSize >= MAX_POOLED_RECV_PACKETS)
+    {
+        delete packet;
+        return;
+    }
+
+    ++_recvPacketPoolSize;
+    _recvPacketPool.Enqueue(packet);
 }
 
 /// Logging helper for unexpected opcodes
@@ -306,7 +354,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     constexpr uint32 MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE = 100;
 
-    while (m_Socket && _recvQueue.next(packet, updater))
+    while (m_Socket && NextRecvPacket(packet, updater))
     {
         OpcodeClient opcode = static_cast<OpcodeClient>(packet->GetOpcode());
         ClientOpcodeHandler const* opHandle = opcodeTable[opcode];
@@ -448,7 +496,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
         }
 
         if (deletePacket)
-            delete packet;
+            ReleaseRecvPacket(packet);
 
         deletePacket = true;
 
@@ -462,7 +510,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     TC_METRIC_VALUE("processed_packets", processedPackets);
 
-    _recvQueue.readd(requeuePackets.begin(), requeuePackets.end());
+    _requeuedPackets.insert(_requeuedPackets.begin(), requeuePackets.begin(), requeuePackets.end());
 
     if (!updater.ProcessUnsafe()) // <=> updater is of type MapSessionFilter
     {
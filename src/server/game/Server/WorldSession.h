@@ -26,10 +26,12 @@
 #include "AsyncCallbackProcessor.h"
 #include "AuthDefines.h"
 #include "DatabaseEnvFwd.h"
-#include "LockedQueue.h"
 #include "ObjectGuid.h"
 #include "Packet.h"
 #include "SharedDefines.h"
+#include "SPSCQueue.h"
+#include <atomic>
+#include <deque>
 #include <string>
 #include <map>
 #include <memory>
@@ -483,6 +485,8 @@ class TC_GAME_API WorldSession
         bool DisallowHyperlinksAndMaybeKick(std::string const& str);
 
         void QueuePacket(WorldPacket* new_packet);
+        // Network thread only, returns a processed packet to be filled instead of allocating a new one
+        WorldPacket* AcquireRecvPacket();
         bool Update(uint32 diff, PacketFilter& updater);
 
         /// Handle the authentication waiting queue (to be completed)
@@ -1168,6 +1172,10 @@ class TC_GAME_API WorldSession
         void LogUnexpectedOpcode(WorldPacket* packet, char const* status, const char *reason);
         void LogUnprocessedTail(WorldPacket* packet);
 
+        // receive queue helpers
+        bool NextRecvPacket(WorldPacket*& packet, PacketFilter& updater);
+        void ReleaseRecvPacket(WorldPacket* packet);
+
         // EnumData helpers
         bool IsLegitCharacterForAccount(ObjectGuid lowGUID)
         {
@@ -1230,7 +1238,11 @@ class TC_GAME_API WorldSession
         } _addons;
         uint32 recruiterId;
         bool isRecruiter;
-        LockedQueue<WorldPacket*> _recvQueue;
+        // filled by the network thread, drained by world and map updates which never run at the same time
+        SPSCQueue<WorldPacket*> _recvQueue;
+        std::deque<WorldPacket*> _requeuedPackets;  // taken before _recvQueue, update side only
+        SPSCQueue<WorldPacket*> _recvPacketPool;    // processed packets handed back to the network thread
+        std::atomic<uint32> _recvPacketPoolSize;
         rbac::RBACData* _RBACData;
         uint32 expireTime;
         bool forceExit;
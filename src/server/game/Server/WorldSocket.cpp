@@ -83,37 +83,54 @@ void WorldSocket::CheckIpCallback(PreparedQueryResult result)
 
 bool WorldSocket::Update()
 {
+    // payloads at least this large are not copied into the send buffer, their storage is moved and queued right after the buffer holding their header
+    // (SendPacket still copies every payload once into its EncryptablePacket)
+    constexpr std::size_t MIN_MOVED_PAYLOAD_SIZE = 1024;
+    // packets whose headers are encrypted together
+    constexpr std::size_t MAX_SEND_BATCH_SIZE = 512;
+
     EncryptablePacket* queued;
-    MessageBuffer buffer(_sendBufferSize);
+    MessageBuffer buffer(std::size_t(0));
     while (_bufferQueue.Dequeue(queued))
     {
-        ServerPktHeader header(queued->size() + 2, queued->GetOpcode());
-        if (queued->NeedsEncryption())
-            _authCrypt.EncryptSend(header.header, header.getHeaderLength());
-
-        if (buffer.GetRemainingSpace() < queued->size() + header.getHeaderLength())
+        _sendPackets.clear();
+        _sendHeaders.Clear();
+        do
         {
-            QueuePacket(std::move(buffer));
-            buffer.Resize(_sendBufferSize);
-        }
+            _sendPackets.push_back(queued);
+            _sendHeaders.Add(queued->size() + 2, queued->GetOpcode(), queued->NeedsEncryption());
+        } while (_sendPackets.size() < MAX_SEND_BATCH_SIZE && _bufferQueue.Dequeue(queued));
 
-        if (buffer.GetRemainingSpace() >= queued->size() + header.getHeaderLength())
+        _sendHeaders.Encrypt(_authCrypt);
+        AddTrafficPackets(_sendPackets.size());
+
+        for (std::size_t i = 0; i < _sendPackets.size(); ++i)
         {
-            buffer.Write(header.header, header.getHeaderLength());
-            if (!queued->empty())
+            queued = _sendPackets[i];
+            std::size_t const headerLength = _sendHeaders.GetHeaderLength(i);
+            bool const copyPayload = queued->size() < MIN_MOVED_PAYLOAD_SIZE && queued->size() + headerLength <= _sendBufferSize;
+            std::size_t const copySize = headerLength + (copyPayload ? queued->size() : 0);
+            if (buffer.GetRemainingSpace() < copySize)
+            {
+                if (buffer.GetActiveSize() > 0)
+                    QueuePacket(std::move(buffer));
+
+                // buffer for a moved payload's header is queued right away, it never holds anything else
+                buffer.Reset();
+                buffer.Resize(copyPayload ? _sendBufferSize : copySize);
+            }
+
+            buffer.Write(_sendHeaders.GetHeader(i), headerLength);
+            if (!copyPayload)
+            {
+                QueuePacket(std::move(buffer));
+                QueuePacket(MessageBuffer(queued->Move()));
+            }
+            else if (!queued->empty())
                 buffer.Write(queued->contents(), queued->size());
-        }
-        else    // single packet larger than 4096 bytes
-        {
-            MessageBuffer packetBuffer(queued->size() + header.getHeaderLength());
-            packetBuffer.Write(header.header, header.getHeaderLength());
-            if (!queued->empty())
-                packetBuffer.Write(queued->contents(), queued->size());
 
-            QueuePacket(std::move(packetBuffer));
+            delete queued;
         }
-
-        delete queued;
     }
 
     if (buffer.GetActiveSize() > 0)
@@ -301,7 +318,8 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
     OpcodeClient opcode = static_cast<OpcodeClient>(header->cmd);
 
     WorldPacket packet(opcode, std::move(_packetBuffer));
-    WorldPacket* packetToQueue;
+    TimePoint receivedTime;
+    AddTrafficPackets(1);
 
     if (sPacketLog->CanLogPacket())
         sPacketLog->LogPacket(packet, CLIENT_TO_SERVER, GetRemoteIpAddress(), GetRemotePort());
@@ -356,11 +374,10 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
             TC_LOG_ERROR("network", "WorldSocket::ReadDataHandler: client %s sent CMSG_KEEP_ALIVE without being authenticated", GetRemoteIpAddress().to_string().c_str());
             return ReadDataHandlerResult::Error;
         case CMSG_TIME_SYNC_RESP:
-            packetToQueue = new WorldPacket(std::move(packet), std::chrono::steady_clock::now());
+            receivedTime = std::chrono::steady_clock::now();
             break;
 
         default:
-            packetToQueue = new WorldPacket(std::move(packet));
             break;
     }
 
@@ -371,7 +388,6 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
     if (!_worldSession)
     {
         TC_LOG_ERROR("network.opcode", "ProcessIncoming: Client not authed opcode = %u", uint32(opcode));
-        delete packetToQueue;
         return ReadDataHandlerResult::Error;
     }
 
@@ -379,14 +395,16 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
     if (!handler)
     {
         TC_LOG_ERROR("network.opcode", "No defined handler for opcode %s sent by %s", GetOpcodeNameForLogging(static_cast<OpcodeClient>(packet.GetOpcode())).c_str(), _worldSession->GetPlayerInfo().c_str());
-        delete packetToQueue;
         return ReadDataHandlerResult::Error;
     }
 
     // Our Idle timer will reset on any non PING opcodes on login screen, allowing us to catch people idling.
     _worldSession->ResetTimeOutTime(false);
 
-    // Copy the packet to the heap before enqueuing
+    // Move the packet into one the session already processed before enqueuing
+    WorldPacket* packetToQueue = _worldSession->AcquireRecvPacket();
+    *packetToQueue = std::move(packet);
+    packetToQueue->SetReceivedTime(receivedTime);
     _worldSession->QueuePacket(packetToQueue);
 
     return ReadDataHandlerResult::Ok;
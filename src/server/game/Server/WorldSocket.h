@@ -125,6 +125,8 @@ private:
     MessageBuffer _headerBuffer;
     MessageBuffer _packetBuffer;
     MPSCQueue<EncryptablePacket, &EncryptablePacket::SocketQueueLink> _bufferQueue;
+    std::vector<EncryptablePacket*> _sendPackets;
+    ServerPktHeaderBatch _sendHeaders;
     std::size_t _sendBufferSize;
 
     QueryCallbackProcessor _queryProcessor;
@@ -422,6 +422,20 @@ void AuraEffect::GetApplicationList(Container& applicationContainer) const
     }
 }
 
+void AuraEffect::SetAmount(int32 amount)
+{
+    _amount = amount;
+    m_canBeRecalculated = false;
+
+    // targets cache aura modifier totals, ChangeAmount re-registers the effect but scripts may set amount directly
+    Aura::ApplicationMap const& targetMap = GetBase()->GetApplicationMap();
+    for (auto appIter = targetMap.begin(); appIter != targetMap.end(); ++appIter)
+    {
+        if (appIter->second->HasEffect(GetEffIndex()))
+            appIter->second->GetTarget()->InvalidateAuraModifierTotals(GetAuraType());
+    }
+}
+
 int32 AuraEffect::CalculateAmount(Unit* caster)
 {
     // default amount calculation
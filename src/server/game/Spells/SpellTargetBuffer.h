@@ -0,0 +1,81 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_SPELLTARGETBUFFER_H
+#define TRINITY_SPELLTARGETBUFFER_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+class WorldObject;
+
+/**
+ * Scratch storage of implicit target searches, taken from a per thread pool and returned on destruction.
+ * Selections nest (chain targets search area targets, script handlers may cast further spells) so every level owns a buffer.
+ */
+template<class T>
+class PooledTargetBuffer
+{
+public:
+    static constexpr std::size_t MAX_POOLED_BUFFERS = 8;
+    static constexpr std::size_t MAX_POOLED_BUFFER_CAPACITY = 1024;
+
+    PooledTargetBuffer() : _targets(Acquire()) { }
+    ~PooledTargetBuffer() { Release(std::move(_targets)); }
+
+    std::vector<T>& operator*() { return _targets; }
+
+    static std::size_t GetPooledCount() { return GetPool().size(); }
+
+private:
+    static std::vector<std::vector<T>>& GetPool()
+    {
+        thread_local std::vector<std::vector<T>> pool;
+        return pool;
+    }
+
+    static std::vector<T> Acquire()
+    {
+        std::vector<std::vector<T>>& pool = GetPool();
+        if (pool.empty())
+            return {};
+
+        std::vector<T> targets = std::move(pool.back());
+        pool.pop_back();
+        return targets;
+    }
+
+    static void Release(std::vector<T>&& targets)
+    {
+        std::vector<std::vector<T>>& pool = GetPool();
+        if (pool.size() >= MAX_POOLED_BUFFERS || targets.capacity() > MAX_POOLED_BUFFER_CAPACITY)
+            return;
+
+        targets.clear();
+        pool.push_back(std::move(targets));
+    }
+
+    std::vector<T> _targets;
+
+    PooledTargetBuffer(PooledTargetBuffer const& right) = delete;
+    PooledTargetBuffer& operator=(PooledTargetBuffer const& right) = delete;
+};
+
+typedef PooledTargetBuffer<WorldObject*> SpellTargetBuffer;
+
+#endif
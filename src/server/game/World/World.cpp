@@ -64,6 +64,7 @@
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "OutdoorPvPMgr.h"
+#include "PacketBufferPool.h"
 #include "PetitionMgr.h"
 #include "Player.h"
 #include "PlayerDump.h"
@@ -81,6 +82,7 @@
 #include "TicketMgr.h"
 #include "TransportMgr.h"
 #include "Unit.h"
+#include "UpdateData.h"
 #include "UpdateTime.h"
 #include "VMapFactory.h"
 #include "VMapManager2.h"
@@ -92,6 +94,7 @@
 #endif
 #include "WhoListStorage.h"
 #include "WorldSession.h"
+#include "WorldSocketMgr.h"
 
 #include <boost/asio/ip/address.hpp>
 
@@ -681,6 +684,14 @@ void World::LoadConfigSettings(bool reload)
         TC_LOG_ERROR("server.loading", "Compression level (%i) must be in range 1..9. Using default compression level (1).", m_int_configs[CONFIG_COMPRESSION]);
         m_int_configs[CONFIG_COMPRESSION] = 1;
     }
+    m_int_configs[CONFIG_COMPRESSION_THRESHOLD] = sConfigMgr->GetIntDefault("Compression.Threshold", 100);
+    m_int_configs[CONFIG_COMPRESSION_LARGE_PACKET_SIZE] = sConfigMgr->GetIntDefault("Compression.LargePacketSize", 0);
+    m_int_configs[CONFIG_COMPRESSION_LARGE_PACKET] = sConfigMgr->GetIntDefault("Compression.LargePacketLevel", m_int_configs[CONFIG_COMPRESSION]);
+    if (m_int_configs[CONFIG_COMPRESSION_LARGE_PACKET] < 1 || m_int_configs[CONFIG_COMPRESSION_LARGE_PACKET] > 9)
+    {
+        TC_LOG_ERROR("server.loading", "Compression.LargePacketLevel (%i) must be in range 1..9. Using Compression level (%u).", m_int_configs[CONFIG_COMPRESSION_LARGE_PACKET], m_int_configs[CONFIG_COMPRESSION]);
+        m_int_configs[CONFIG_COMPRESSION_LARGE_PACKET] = m_int_configs[CONFIG_COMPRESSION];
+    }
     m_bool_configs[CONFIG_ADDON_CHANNEL] = sConfigMgr->GetBoolDefault("AddonChannel", true);
     m_bool_configs[CONFIG_CLEAN_CHARACTER_DB] = sConfigMgr->GetBoolDefault("CleanCharacterDB", false);
     m_int_configs[CONFIG_PERSISTENT_CHARACTER_CLEAN_FLAGS] = sConfigMgr->GetIntDefault("PersistentCharacterCleanFlags", 0);
@@ -1321,6 +1332,14 @@ void World::LoadConfigSettings(bool reload)
     m_visibility_notify_periodInInstances  = sConfigMgr->GetIntDefault("Visibility.Notify.Period.InInstances",  DEFAULT_VISIBILITY_NOTIFY_PERIOD);
     m_visibility_notify_periodInBG         = sConfigMgr->GetIntDefault("Visibility.Notify.Period.InBG",         DEFAULT_VISIBILITY_NOTIFY_PERIOD);
     m_visibility_notify_periodInArenas     = sConfigMgr->GetIntDefault("Visibility.Notify.Period.InArenas",     DEFAULT_VISIBILITY_NOTIFY_PERIOD);
+
+    m_float_configs[CONFIG_VISIBILITY_HYSTERESIS] = sConfigMgr->GetFloatDefault("Visibility.Hysteresis", 5.0f);
+    if (m_float_configs[CONFIG_VISIBILITY_HYSTERESIS] < 0.0f)
+    {
+        TC_LOG_ERROR("server.loading", "Visibility.Hysteresis (%f) must be >= 0. Using 0 instead.", m_float_configs[CONFIG_VISIBILITY_HYSTERESIS]);
+        m_float_configs[CONFIG_VISIBILITY_HYSTERESIS] = 0.0f;
+    }
+    m_bool_configs[CONFIG_VISIBILITY_INCREMENTAL] = sConfigMgr->GetBoolDefault("Visibility.Incremental", true);
 	
 	//Taxi Speed
 	m_float_configs[CONFIG_SPEED_TAXI] = sConfigMgr->GetFloatDefault("Custom.SpeedTaxi", 1.0f);
@@ -1424,6 +1443,8 @@ void World::LoadConfigSettings(bool reload)
     }
 
     m_bool_configs[CONFIG_ENABLE_MMAPS] = sConfigMgr->GetBoolDefault("mmap.enablePathFinding", true);
+    m_int_configs[CONFIG_MMAP_ASYNC_THREADS] = sConfigMgr->GetIntDefault("mmap.AsyncThreads", 0);
+    m_int_configs[CONFIG_MMAP_PATH_CACHE_SIZE] = sConfigMgr->GetIntDefault("mmap.PathCacheSize", 0);
     TC_LOG_INFO("server.loading", "WORLD: MMap data directory is: %smmaps", m_dataPath.c_str());
 
     m_bool_configs[CONFIG_VMAP_INDOOR_CHECK] = sConfigMgr->GetBoolDefault("vmap.enableIndoorCheck", 0);
@@ -1460,6 +1481,7 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_SHOW_MUTE_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowMuteInWorld", false);
     m_bool_configs[CONFIG_SHOW_BAN_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowBanInWorld", false);
     m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
+    m_bool_configs[CONFIG_GRID_POSITION_PREFILTER] = sConfigMgr->GetBoolDefault("Grid.PositionPrefilter", true);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
     // Warden
@@ -1671,6 +1693,7 @@ void World::SetInitialWorldSettings()
 
     MMAP::MMapManager* mmmgr = MMAP::MMapFactory::createOrGetMMapManager();
     mmmgr->InitializeThreadUnsafe(mapIds);
+    mmmgr->SetPathCacheSize(getIntConfig(CONFIG_MMAP_PATH_CACHE_SIZE));
 
     TC_LOG_INFO("server.loading", "Initializing PlayerDump tables...");
     PlayerDump::InitializeTables();
@@ -2626,6 +2649,24 @@ void World::Update(uint32 diff)
         // Stats logger update
         sMetric->Update();
         TC_METRIC_VALUE("update_time_diff", diff);
+
+        uint32 pathCacheHits, pathCacheMisses;
+        MMAP::MMapFactory::createOrGetMMapManager()->ResetPathCacheStats(pathCacheHits, pathCacheMisses);
+        TC_METRIC_VALUE("mmap_path_cache_hits", pathCacheHits);
+        TC_METRIC_VALUE("mmap_path_cache_misses", pathCacheMisses);
+
+        UpdateData::CompressionStats compressionStats = UpdateData::ResetCompressionStats();
+        TC_METRIC_VALUE("update_compression_bytes_in", compressionStats.BytesIn);
+        TC_METRIC_VALUE("update_compression_bytes_out", compressionStats.BytesOut);
+        TC_METRIC_VALUE("update_compression_time", compressionStats.TimeMicroseconds);
+
+        PacketBufferPool::Stats packetPoolStats = PacketBufferPool::ResetStats();
+        TC_METRIC_VALUE("packet_pool_hits", packetPoolStats.Hits);
+        TC_METRIC_VALUE("packet_pool_misses", packetPoolStats.Misses);
+        TC_METRIC_VALUE("packet_pool_bytes", packetPoolStats.Bytes);
+        TC_METRIC_VALUE("packet_pool_peak_bytes", packetPoolStats.PeakBytes);
+
+        sWorldSocketMgr.LogThreadMetrics();
     }
 }
 
@@ -185,6 +185,8 @@ enum WorldBoolConfigs
 	CONFIG_GAIN_HONOR_GUARD_AP,
     CONFIG_GAIN_HONOR_ELITE_AP,
 	CONFIG_GAIN_HONOR_BOSS_AP,
+    CONFIG_GRID_POSITION_PREFILTER,
+    CONFIG_VISIBILITY_INCREMENTAL,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -214,6 +216,7 @@ enum WorldFloatConfigs
 	CONFIG_SPEED_GAME,
 	CONFIG_ATTACKSPEED_PLAYER,
     CONFIG_ATTACKSPEED_ALL,
+    CONFIG_VISIBILITY_HYSTERESIS,
     FLOAT_CONFIG_VALUE_COUNT
 };
 
@@ -417,6 +420,11 @@ enum WorldIntConfigs
 	CONFIG_GAIN_HONOR_GUARD_GOLD,
     CONFIG_GAIN_HONOR_ELITE_GOLD,
 	CONFIG_GAIN_HONOR_BOSS_GOLD,
+    CONFIG_MMAP_ASYNC_THREADS,
+    CONFIG_MMAP_PATH_CACHE_SIZE,
+    CONFIG_COMPRESSION_THRESHOLD,
+    CONFIG_COMPRESSION_LARGE_PACKET_SIZE,
+    CONFIG_COMPRESSION_LARGE_PACKET,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -1163,7 +1163,7 @@ public:
 
                 WorldDatabasePreparedStatement* stmt = WorldDatabase.GetPreparedStatement(WORLD_SEL_ITEM_TEMPLATE_BY_NAME);
                 stmt->setString(0, itemName);
-                PreparedQueryResult result = WorldDatabase.Query(stmt);
+                PreparedQueryResult result = WorldDatabase.CachedQuery(stmt);
 
                 if (!result)
                 {
@@ -1302,7 +1302,7 @@ public:
 
                 WorldDatabasePreparedStatement* stmt = WorldDatabase.GetPreparedStatement(WORLD_SEL_ITEM_TEMPLATE_BY_NAME);
                 stmt->setString(0, itemName);
-                PreparedQueryResult result = WorldDatabase.Query(stmt);
+                PreparedQueryResult result = WorldDatabase.CachedQuery(stmt);
 
                 if (!result)
                 {
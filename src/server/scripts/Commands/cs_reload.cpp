@@ -209,6 +209,8 @@ public:
 
         HandleReloadAutobroadcastCommand(handler, "");
         HandleReloadBattlegroundTemplate(handler, "");
+
+        WorldDatabase.InvalidateQueryCache();
         return true;
     }
 
@@ -309,6 +311,7 @@ public:
     {
         HandleReloadPageTextsCommand(handler, "a");
         HandleReloadItemEnchantementsCommand(handler, "a");
+        WorldDatabase.InvalidateQueryCache(WORLD_SEL_ITEM_TEMPLATE_BY_NAME);
         return true;
     }
 
@@ -704,6 +707,7 @@ public:
     static bool HandleReloadNpcVendorCommand(ChatHandler* handler, char const* /*args*/)
     {
         TC_LOG_INFO("misc", "Re-Loading `npc_vendor` Table!");
+        WorldDatabase.InvalidateQueryCache(WORLD_SEL_NPC_VENDOR_REF);
         sObjectMgr->LoadVendors();
         handler->SendGlobalGMSysMessage("DB table `npc_vendor` reloaded.");
         return true;
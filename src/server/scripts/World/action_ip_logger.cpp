@@ -149,7 +149,7 @@ class AccountActionIpLogger : public AccountScript
                 stmt->setUInt8(3, aType);
                 stmt->setUInt32(4, playerGuid);
                 stmt->setString(5, systemNote);
-                LoginDatabase.Execute(stmt);
+                LoginDatabase.Execute(stmt, SQL_PRIORITY_BACKGROUND);
             }
             else // ... but for failed login, we query last_attempt_ip from account table. Which we do with an unique query
             {
@@ -161,7 +161,7 @@ class AccountActionIpLogger : public AccountScript
                 stmt->setUInt8(3, aType);
                 stmt->setUInt32(4, playerGuid);
                 stmt->setString(5, systemNote);
-                LoginDatabase.Execute(stmt);
+                LoginDatabase.Execute(stmt, SQL_PRIORITY_BACKGROUND);
             }
             return;
         }
@@ -248,7 +248,7 @@ class CharacterActionIpLogger : public PlayerScript
             // Seeing as the time differences should be minimal, we do not get unixtime and the timestamp right now;
             // Rather, we let it be added with the SQL query.
 
-            LoginDatabase.Execute(stmt);
+            LoginDatabase.Execute(stmt, SQL_PRIORITY_BACKGROUND);
             return;
         }
 };
@@ -311,7 +311,7 @@ public:
         // Seeing as the time differences should be minimal, we do not get unixtime and the timestamp right now;
         // Rather, we let it be added with the SQL query.
 
-        LoginDatabase.Execute(stmt);
+        LoginDatabase.Execute(stmt, SQL_PRIORITY_BACKGROUND);
         return;
     }
 };
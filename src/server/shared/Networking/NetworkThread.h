@@ -23,6 +23,7 @@
 #include "Errors.h"
 #include "IoContext.h"
 #include "Log.h"
+#include "Socket.h"
 #include "Timer.h"
 #include <boost/asio/ip/tcp.hpp>
 #include <atomic>
@@ -38,8 +39,8 @@ template<class SocketType>
 class NetworkThread
 {
 public:
-    NetworkThread() : _connections(0), _stopped(false), _thread(nullptr), _ioContext(1),
-        _acceptSocket(_ioContext), _updateTimer(_ioContext)
+    NetworkThread() : _connections(0), _bytesPerSecond(0), _packetsPerSecond(0), _stopped(false), _thread(nullptr),
+        _trafficSampleStart(std::chrono::steady_clock::now()), _ioContext(1), _acceptSocket(_ioContext), _updateTimer(_ioContext)
     {
     }
 
@@ -82,6 +83,10 @@ public:
         return _connections;
     }
 
+    // traffic of all sockets of this thread, averaged over last two seconds
+    uint32 GetBytesPerSecond() const { return _bytesPerSecond; }
+    uint32 GetPacketsPerSecond() const { return _packetsPerSecond; }
+
     virtual void AddSocket(std::shared_ptr<SocketType> sock)
     {
         std::lock_guard<std::mutex> lock(_newSocketsLock);
@@ -143,6 +148,10 @@ protected:
 
         _sockets.erase(std::remove_if(_sockets.begin(), _sockets.end(), [this](std::shared_ptr<SocketType> sock)
         {
+            SocketTraffic traffic = sock->TakeTraffic();
+            this->_sampleTraffic.Bytes += traffic.Bytes;
+            this->_sampleTraffic.Packets += traffic.Packets;
+
             if (!sock->Update())
             {
                 if (sock->IsOpen())
@@ -156,16 +165,37 @@ protected:
 
             return false;
         }), _sockets.end());
+
+        SampleTraffic();
+    }
+
+    void SampleTraffic()
+    {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed = now - _trafficSampleStart;
+        if (elapsed < std::chrono::seconds(1))
+            return;
+
+        // averaged with previous rate so a single burst does not flip thread selection
+        _bytesPerSecond = uint32((_bytesPerSecond + _sampleTraffic.Bytes / elapsed.count()) / 2);
+        _packetsPerSecond = uint32((_packetsPerSecond + _sampleTraffic.Packets / elapsed.count()) / 2);
+        _sampleTraffic = SocketTraffic();
+        _trafficSampleStart = now;
     }
 
 private:
     typedef std::vector<std::shared_ptr<SocketType>> SocketContainer;
 
     std::atomic<int32> _connections;
+    std::atomic<uint32> _bytesPerSecond;
+    std::atomic<uint32> _packetsPerSecond;
     std::atomic<bool> _stopped;
 
     std::thread* _thread;
 
+    SocketTraffic _sampleTraffic;
+    std::chrono::steady_clock::time_point _trafficSampleStart;
+
     SocketContainer _sockets;
 
     std::mutex _newSocketsLock;
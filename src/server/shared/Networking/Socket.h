@@ -20,20 +20,31 @@
 
 #include "MessageBuffer.h"
 #include "Log.h"
+#include <algorithm>
 #include <atomic>
-#include <queue>
+#include <deque>
 #include <memory>
 #include <functional>
 #include <type_traits>
+#include <vector>
 #include <boost/asio/ip/tcp.hpp>
 
 using boost::asio::ip::tcp;
 
 #define READ_BLOCK_SIZE 4096
+// buffers submitted in one vectored write, well below IOV_MAX on supported platforms
+#define WRITE_MAX_BUFFERS 64
 #ifdef BOOST_ASIO_HAS_IOCP
 #define TC_SOCKET_USE_IOCP
 #endif
 
+/// Traffic of a socket, counted on its network thread
+struct SocketTraffic
+{
+    std::size_t Bytes = 0;
+    std::size_t Packets = 0;
+};
+
 template<class T>
 class Socket : public std::enable_shared_from_this<T>
 {
@@ -42,6 +53,7 @@ public:
         _remotePort(_socket.remote_endpoint().port()), _readBuffer(), _closed(false), _closing(false), _isWritingAsync(false)
     {
         _readBuffer.Resize(READ_BLOCK_SIZE);
+        _writeBuffers.reserve(WRITE_MAX_BUFFERS);
     }
 
     virtual ~Socket()
@@ -101,9 +113,10 @@ public:
             std::bind(callback, this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
     }
 
+    /// Queued buffers are written in order, several of them at once with a single vectored write
     void QueuePacket(MessageBuffer&& buffer)
     {
-        _writeQueue.push(std::move(buffer));
+        _writeQueue.push_back(std::move(buffer));
 
 #ifdef TC_SOCKET_USE_IOCP
         AsyncProcessQueue();
@@ -131,11 +144,21 @@ public:
 
     MessageBuffer& GetReadBuffer() { return _readBuffer; }
 
+    /// Bytes sent and received plus packets reported by the derived socket since last call
+    SocketTraffic TakeTraffic()
+    {
+        SocketTraffic traffic = _traffic;
+        _traffic = SocketTraffic();
+        return traffic;
+    }
+
 protected:
     virtual void OnClose() { }
 
     virtual void ReadHandler() = 0;
 
+    void AddTrafficPackets(std::size_t packets) { _traffic.Packets += packets; }
+
     bool AsyncProcessQueue()
     {
         if (_isWritingAsync)
@@ -144,8 +167,8 @@ protected:
         _isWritingAsync = true;
 
 #ifdef TC_SOCKET_USE_IOCP
-        MessageBuffer& buffer = _writeQueue.front();
-        _socket.async_write_some(boost::asio::buffer(buffer.GetReadPointer(), buffer.GetActiveSize()), std::bind(&Socket<T>::WriteHandler,
+        GatherWriteBuffers();
+        _socket.async_write_some(_writeBuffers, std::bind(&Socket<T>::WriteHandler,
             this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
 #else
         _socket.async_write_some(boost::asio::null_buffers(), std::bind(&Socket<T>::WriteHandlerWrapper,
@@ -174,9 +197,43 @@ private:
         }
 
         _readBuffer.WriteCompleted(transferredBytes);
+        _traffic.Bytes += transferredBytes;
         ReadHandler();
     }
 
+    /// Collects front of the write queue into _writeBuffers, returns number of bytes they hold
+    std::size_t GatherWriteBuffers()
+    {
+        _writeBuffers.clear();
+        std::size_t bytes = 0;
+        std::size_t count = std::min<std::size_t>(_writeQueue.size(), WRITE_MAX_BUFFERS);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            MessageBuffer& buffer = _writeQueue[i];
+            _writeBuffers.emplace_back(buffer.GetReadPointer(), buffer.GetActiveSize());
+            bytes += buffer.GetActiveSize();
+        }
+
+        return bytes;
+    }
+
+    /// Consumes sent bytes from the write queue, releasing buffers written completely
+    void WriteCompleted(std::size_t transferedBytes)
+    {
+        _traffic.Bytes += transferedBytes;
+        while (!_writeQueue.empty())
+        {
+            MessageBuffer& buffer = _writeQueue.front();
+            std::size_t bytes = std::min(transferedBytes, buffer.GetActiveSize());
+            buffer.ReadCompleted(bytes);
+            transferedBytes -= bytes;
+            if (buffer.GetActiveSize())
+                break;
+
+            _writeQueue.pop_front();
+        }
+    }
+
 #ifdef TC_SOCKET_USE_IOCP
 
     void WriteHandler(boost::system::error_code error, std::size_t transferedBytes)
@@ -184,9 +241,7 @@ private:
         if (!error)
         {
             _isWritingAsync = false;
-            _writeQueue.front().ReadCompleted(transferedBytes);
-            if (!_writeQueue.front().GetActiveSize())
-                _writeQueue.pop();
+            WriteCompleted(transferedBytes);
 
             if (!_writeQueue.empty())
                 AsyncProcessQueue();
@@ -210,37 +265,35 @@ private:
         if (_writeQueue.empty())
             return false;
 
-        MessageBuffer& queuedMessage = _writeQueue.front();
-
-        std::size_t bytesToSend = queuedMessage.GetActiveSize();
+        std::size_t bytesToSend = GatherWriteBuffers();
 
         boost::system::error_code error;
-        std::size_t bytesSent = _socket.write_some(boost::asio::buffer(queuedMessage.GetReadPointer(), bytesToSend), error);
+        std::size_t bytesSent = _socket.write_some(_writeBuffers, error);
 
         if (error)
         {
             if (error == boost::asio::error::would_block || error == boost::asio::error::try_again)
                 return AsyncProcessQueue();
 
-            _writeQueue.pop();
+            _writeQueue.pop_front();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
         else if (bytesSent == 0)
         {
-            _writeQueue.pop();
+            _writeQueue.pop_front();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
         else if (bytesSent < bytesToSend) // now n > 0
         {
-            queuedMessage.ReadCompleted(bytesSent);
+            WriteCompleted(bytesSent);
             return AsyncProcessQueue();
         }
 
-        _writeQueue.pop();
+        WriteCompleted(bytesSent);
         if (_closing && _writeQueue.empty())
             CloseSocket();
         return !_writeQueue.empty();
@@ -254,7 +307,10 @@ private:
     uint16 _remotePort;
 
     MessageBuffer _readBuffer;
-    std::queue<MessageBuffer> _writeQueue;
+    std::deque<MessageBuffer> _writeQueue;
+    std::vector<boost::asio::const_buffer> _writeBuffers;
+
+    SocketTraffic _traffic;
 
     std::atomic<bool> _closed;
     std::atomic<bool> _closing;
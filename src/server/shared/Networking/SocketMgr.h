@@ -20,9 +20,11 @@
 
 #include "AsyncAcceptor.h"
 #include "Errors.h"
+#include "Metric.h"
 #include "NetworkThread.h"
 #include <boost/asio/ip/tcp.hpp>
 #include <memory>
+#include <string>
 
 using boost::asio::ip::tcp;
 
@@ -112,20 +114,39 @@ public:
 
     int32 GetNetworkThreadCount() const { return _threadCount; }
 
-    uint32 SelectThreadWithMinConnections() const
+    /// Selects thread with least traffic, connections are weighted too so idle ones are still spread evenly
+    uint32 SelectThreadWithMinLoad() const
     {
         uint32 min = 0;
+        uint64 minLoad = GetThreadLoad(0);
 
         for (int32 i = 1; i < _threadCount; ++i)
-            if (_threads[i].GetConnectionCount() < _threads[min].GetConnectionCount())
+        {
+            uint64 load = GetThreadLoad(i);
+            if (load < minLoad)
+            {
                 min = i;
+                minLoad = load;
+            }
+        }
 
         return min;
     }
 
+    void LogThreadMetrics() const
+    {
+        for (int32 i = 0; i < _threadCount; ++i)
+        {
+            std::string thread = std::to_string(i);
+            TC_METRIC_VALUE("network_thread_connections", _threads[i].GetConnectionCount(), TC_METRIC_TAG("thread", thread));
+            TC_METRIC_VALUE("network_thread_bytes", _threads[i].GetBytesPerSecond(), TC_METRIC_TAG("thread", thread));
+            TC_METRIC_VALUE("network_thread_packets", _threads[i].GetPacketsPerSecond(), TC_METRIC_TAG("thread", thread));
+        }
+    }
+
     std::pair<tcp::socket*, uint32> GetSocketForAccept()
     {
-        uint32 threadIndex = SelectThreadWithMinConnections();
+        uint32 threadIndex = SelectThreadWithMinLoad();
         return std::make_pair(_threads[threadIndex].GetSocketForAccept(), threadIndex);
     }
 
@@ -136,6 +157,16 @@ protected:
 
     virtual NetworkThread<SocketType>* CreateThreads() const = 0;
 
+    // load in bytes per second, a connection and a packet count as this many bytes
+    static constexpr uint64 CONNECTION_LOAD = 2048;
+    static constexpr uint64 PACKET_LOAD = 64;
+
+    uint64 GetThreadLoad(uint32 threadIndex) const
+    {
+        NetworkThread<SocketType> const& thread = _threads[threadIndex];
+        return thread.GetBytesPerSecond() + thread.GetPacketsPerSecond() * PACKET_LOAD + thread.GetConnectionCount() * CONNECTION_LOAD;
+    }
+
     AsyncAcceptor* _acceptor;
     NetworkThread<SocketType>* _threads;
     int32 _threadCount;
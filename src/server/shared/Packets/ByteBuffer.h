@@ -20,9 +20,9 @@
 
 #include "Define.h"
 #include "ByteConverter.h"
+#include "PacketBufferPool.h"
 #include <array>
 #include <string>
-#include <vector>
 #include <cstring>
 
 class MessageBuffer;
@@ -126,6 +126,13 @@ class TC_SHARED_API ByteBuffer
             _rpos = _wpos = 0;
         }
 
+        // Gives away the storage, buffer is left empty
+        PacketBufferStorage&& Move()
+        {
+            _rpos = _wpos = 0;
+            return std::move(_storage);
+        }
+
         template <typename T> void append(T value)
         {
             static_assert(std::is_fundamental<T>::value, "append(compound)");
@@ -500,7 +507,7 @@ class TC_SHARED_API ByteBuffer
 
     protected:
         size_t _rpos, _wpos;
-        std::vector<uint8> _storage;
+        PacketBufferStorage _storage;
 };
 
 /// @todo Make a ByteBuffer.cpp and move all this inlining to it.
@@ -48,6 +48,7 @@
 #include "ScriptReloadMgr.h"
 #include "SecretMgr.h"
 #include "SharedDefines.h"
+#include "SQLOperationQueue.h"
 #include "TCSoap.h"
 #include "ThreadPool.h"
 #include "World.h"
@@ -117,6 +118,7 @@ void SignalHandler(boost::system::error_code const& error, int signalNumber);
 AsyncAcceptor* StartRaSocketAcceptor(Trinity::Asio::IoContext& ioContext);
 bool StartDB();
 void StopDB();
+template<class T> void LogDatabaseQueueMetrics(DatabaseWorkerPool<T>& database, std::string const& name);
 void WorldUpdateLoop();
 void ClearOnlineAccounts();
 void ShutdownCLIThread(std::thread* cliThread);
@@ -281,6 +283,9 @@ extern int main(int argc, char** argv)
         TC_METRIC_VALUE("db_queue_login", uint64(LoginDatabase.QueueSize()));
         TC_METRIC_VALUE("db_queue_character", uint64(CharacterDatabase.QueueSize()));
         TC_METRIC_VALUE("db_queue_world", uint64(WorldDatabase.QueueSize()));
+        LogDatabaseQueueMetrics(LoginDatabase, "login");
+        LogDatabaseQueueMetrics(CharacterDatabase, "character");
+        LogDatabaseQueueMetrics(WorldDatabase, "world");
     });
 
     TC_METRIC_EVENT("events", "Worldserver started", "");
@@ -675,6 +680,23 @@ void StopDB()
     MySQL::Library_End();
 }
 
+/// Depth and wait times of every async queue priority lane since previous call
+template<class T>
+void LogDatabaseQueueMetrics(DatabaseWorkerPool<T>& database, std::string const& name)
+{
+    static char const* const priorityNames[MAX_SQL_PRIORITY] = { "interactive", "save", "background" };
+
+    SQLOperationQueueStats stats = database.ResetQueueStats();
+    for (uint32 i = 0; i < MAX_SQL_PRIORITY; ++i)
+    {
+        SQLOperationQueueStats::Lane const& lane = stats.Lanes[i];
+        std::string priority = priorityNames[i];
+        TC_METRIC_VALUE("db_queue_lane_" + name, uint64(database.QueueSize(SQLOperationPriority(i))), TC_METRIC_TAG("priority", priority));
+        TC_METRIC_VALUE("db_queue_wait_avg_" + name, lane.Operations ? lane.TotalWait / lane.Operations : 0, TC_METRIC_TAG("priority", priority));
+        TC_METRIC_VALUE("db_queue_wait_max_" + name, lane.MaxWait, TC_METRIC_TAG("priority", priority));
+    }
+}
+
 /// Clear 'online' status for all accounts with characters in this realm
 void ClearOnlineAccounts()
 {
@@ -0,0 +1,169 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "NodePool.h"
+#include <list>
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct Node
+    {
+        void* Links[3];
+        uint32 Key;
+    };
+
+    // owned/applied aura maps and the per aura type effect list, as Unit keeps them
+    template<template<typename> class Allocator>
+    struct AuraContainers
+    {
+        std::multimap<uint32, void*, std::less<uint32>, Allocator<std::pair<uint32 const, void*>>> OwnedAuras;
+        std::multimap<uint32, void*, std::less<uint32>, Allocator<std::pair<uint32 const, void*>>> AppliedAuras;
+        std::list<void*, Allocator<void*>> ModAuras[8];
+    };
+
+    // a bot party rebuffing, every aura is removed and applied again each round
+    template<template<typename> class Allocator>
+    uint64 Churn(std::size_t units, std::size_t aurasPerUnit, std::size_t rounds)
+    {
+        std::vector<AuraContainers<Allocator>> containers(units);
+        uint64 checksum = 0;
+        for (std::size_t round = 0; round < rounds; ++round)
+        {
+            for (AuraContainers<Allocator>& unit : containers)
+            {
+                for (uint32 spellId = 0; spellId < aurasPerUnit; ++spellId)
+                {
+                    void* aura = reinterpret_cast<void*>(uintptr_t(spellId + 1));
+                    unit.OwnedAuras.emplace(spellId, aura);
+                    unit.AppliedAuras.emplace(spellId, aura);
+                    unit.ModAuras[spellId % 8].push_back(aura);
+                }
+
+                checksum += unit.AppliedAuras.size();
+
+                for (uint32 spellId = 0; spellId < aurasPerUnit; ++spellId)
+                {
+                    void* aura = reinterpret_cast<void*>(uintptr_t(spellId + 1));
+                    unit.OwnedAuras.erase(unit.OwnedAuras.find(spellId));
+                    unit.AppliedAuras.erase(unit.AppliedAuras.find(spellId));
+                    unit.ModAuras[spellId % 8].remove(aura);
+                }
+            }
+        }
+        return checksum;
+    }
+}
+
+TEST_CASE("NodePool: Blocks are reused", "[NodePool]")
+{
+    NodePoolAllocator<Node> allocator;
+    Node* first = allocator.allocate(1);
+    std::size_t const cached = NodePool<sizeof(Node)>::GetCachedBlocks();
+    allocator.deallocate(first, 1);
+    REQUIRE(NodePool<sizeof(Node)>::GetCachedBlocks() == cached + 1);
+
+    Node* second = allocator.allocate(1);
+    REQUIRE(second == first);
+    REQUIRE(NodePool<sizeof(Node)>::GetCachedBlocks() == cached);
+    allocator.deallocate(second, 1);
+
+    // arrays are not pooled
+    Node* array = allocator.allocate(4);
+    allocator.deallocate(array, 4);
+    REQUIRE(NodePool<sizeof(Node)>::GetCachedBlocks() == cached + 1);
+}
+
+TEST_CASE("NodePool: Freelist is bounded", "[NodePool]")
+{
+    std::size_t const count = NodePool<sizeof(Node)>::MAX_CACHED_BLOCKS + 100;
+    NodePoolAllocator<Node> allocator;
+    std::vector<Node*> nodes;
+    for (std::size_t i = 0; i < count; ++i)
+        nodes.push_back(allocator.allocate(1));
+    for (Node* node : nodes)
+        allocator.deallocate(node, 1);
+
+    REQUIRE(NodePool<sizeof(Node)>::GetCachedBlocks() == NodePool<sizeof(Node)>::MAX_CACHED_BLOCKS);
+}
+
+TEST_CASE("NodePool: Nodes freed on another thread", "[NodePool]")
+{
+    constexpr std::size_t Count = 100;
+    NodePoolAllocator<Node> allocator;
+    std::vector<Node*> nodes;
+    for (std::size_t i = 0; i < Count; ++i)
+        nodes.push_back(allocator.allocate(1));
+    std::size_t const cached = NodePool<sizeof(Node)>::GetCachedBlocks();
+
+    // blocks join the freelist of the freeing thread and are served from it again, the rest is released when it exits
+    std::size_t workerStart = 0, workerFreed = 0, workerReused = 0;
+    std::thread([&]()
+    {
+        workerStart = NodePool<sizeof(Node)>::GetCachedBlocks();
+        for (Node* node : nodes)
+            allocator.deallocate(node, 1);
+        workerFreed = NodePool<sizeof(Node)>::GetCachedBlocks();
+        for (Node*& node : nodes)
+            node = allocator.allocate(1);
+        workerReused = NodePool<sizeof(Node)>::GetCachedBlocks();
+        for (Node* node : nodes)
+            allocator.deallocate(node, 1);
+    }).join();
+
+    REQUIRE(workerStart == 0);
+    REQUIRE(workerFreed == Count);
+    REQUIRE(workerReused == 0);
+    REQUIRE(NodePool<sizeof(Node)>::GetCachedBlocks() == cached);
+
+    std::list<uint32, NodePoolAllocator<uint32>> values;
+    for (uint32 i = 0; i < Count; ++i)
+        values.push_back(i);
+
+    std::thread([&values]() { values.clear(); }).join();
+
+    REQUIRE(values.empty());
+    values.push_back(1);
+    REQUIRE(values.size() == 1);
+    REQUIRE(values.front() == 1);
+}
+
+TEST_CASE("NodePool: Aura churn", "[NodePool]")
+{
+    REQUIRE(Churn<NodePoolAllocator>(50, 24, 20) == Churn<std::allocator>(50, 24, 20));
+}
+
+TEST_CASE("NodePool: Aura churn throughput", "[.][benchmark]")
+{
+    // one rebuff round of 500 units with 24 auras each
+    constexpr std::size_t Units = 500;
+    constexpr std::size_t AurasPerUnit = 24;
+
+    BENCHMARK("system allocator")
+    {
+        return Churn<std::allocator>(Units, AurasPerUnit, 1);
+    };
+
+    BENCHMARK("node pool")
+    {
+        return Churn<NodePoolAllocator>(Units, AurasPerUnit, 1);
+    };
+}
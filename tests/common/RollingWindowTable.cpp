@@ -0,0 +1,74 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "RollingWindowTable.h"
+
+TEST_CASE("RollingWindowTable: Sum over window")
+{
+    RollingWindowTable<8, 3> table;
+    REQUIRE(table.GetTotal(1) == 0);
+
+    REQUIRE(table.Add(1, 10));
+    REQUIRE(table.Add(1, 5));
+    REQUIRE(table.Add(2, 7));
+    REQUIRE(table.GetTotal(1) == 15);
+    REQUIRE(table.GetTotal(2) == 7);
+    REQUIRE(table.GetSize() == 2);
+
+    table.Advance();
+    REQUIRE(table.Add(1, 1));
+    REQUIRE(table.GetTotal(1) == 16);
+
+    table.Advance();
+    REQUIRE(table.GetTotal(1) == 16);
+
+    // first period leaves the window
+    table.Advance();
+    REQUIRE(table.GetTotal(1) == 1);
+    REQUIRE(table.GetTotal(2) == 0);
+
+    table.Advance();
+    REQUIRE(table.GetTotal(1) == 0);
+}
+
+TEST_CASE("RollingWindowTable: Capacity")
+{
+    RollingWindowTable<8, 2> table;
+    REQUIRE_FALSE(table.Add(0, 1));
+
+    uint64 key = 1;
+    while (table.Add(key, 1))
+        ++key;
+
+    // one slot is always kept empty
+    REQUIRE(table.GetSize() == table.GetCapacity() - 1);
+    for (uint64 i = 1; i < key; ++i)
+        REQUIRE(table.GetTotal(i) == 1);
+
+    // keys with nothing left in the window are dropped to make room
+    table.Advance();
+    table.Advance();
+    REQUIRE(table.Add(key, 3));
+    REQUIRE(table.GetTotal(key) == 3);
+    REQUIRE(table.GetSize() == 1);
+
+    table.Clear();
+    REQUIRE(table.GetSize() == 0);
+    REQUIRE(table.GetTotal(key) == 0);
+}
@@ -0,0 +1,133 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "GridPositionIndex.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct Object
+    {
+        float X;
+        float Y;
+        float Reach;
+        uint32 Id;
+        uint32 Payload[32]; // units are large, touching one is a cache miss
+    };
+
+    std::vector<Object> MakeCell(std::size_t count, uint32 seed)
+    {
+        // one cell is 66 yards wide
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> coord(0.0f, 66.0f);
+        std::uniform_real_distribution<float> reach(0.3f, 3.0f);
+        std::vector<Object> objects(count);
+        for (uint32 i = 0; i < count; ++i)
+            objects[i] = { coord(rng), coord(rng), reach(rng), i, { } };
+        return objects;
+    }
+
+    bool InRange(Object const& object, float x, float y, float radius)
+    {
+        return std::hypot(object.X - x, object.Y - y) <= radius + object.Reach;
+    }
+
+    GridPositionIndex<Object const> BuildIndex(std::vector<Object> const& objects)
+    {
+        GridPositionIndex<Object const> index;
+        for (Object const& object : objects)
+            index.Add(&object, object.X, object.Y, object.Reach);
+        return index;
+    }
+}
+
+TEST_CASE("GridPositionIndex: Candidates cover all objects in range", "[GridPositionIndex]")
+{
+    std::vector<Object> objects = MakeCell(300, 1);
+    GridPositionIndex<Object const> index = BuildIndex(objects);
+
+    // moved objects
+    for (uint32 i = 0; i < objects.size(); i += 3)
+    {
+        objects[i].X = 66.0f - objects[i].X;
+        index.Update(i, objects[i].X, objects[i].Y, objects[i].Reach);
+    }
+
+    std::vector<uint32> expected;
+    for (Object const& object : objects)
+        if (InRange(object, 20.0f, 30.0f, 8.0f))
+            expected.push_back(object.Id);
+
+    std::vector<uint32> found;
+    index.VisitInRange(20.0f, 30.0f, 8.0f, [&](Object const* object)
+    {
+        if (InRange(*object, 20.0f, 30.0f, 8.0f))
+            found.push_back(object->Id);
+        return true;
+    });
+
+    REQUIRE(!expected.empty());
+    REQUIRE(found == expected);
+
+    uint32 visited = 0;
+    bool visiting = false;
+    index.VisitInRange(20.0f, 30.0f, 100.0f, [&](Object const*) { visiting = index.IsVisited(); return ++visited < 5; });
+    REQUIRE(visited == 5);
+    REQUIRE(visiting);
+    REQUIRE(!index.IsVisited());
+}
+
+TEST_CASE("GridPositionIndex: AoE search in crowded cell", "[GridPositionIndex]")
+{
+    constexpr std::size_t Objects = 400;
+    constexpr std::size_t Searches = 200;
+    constexpr float Radius = 8.0f;
+
+    std::vector<Object> objects = MakeCell(Objects, 2);
+    GridPositionIndex<Object const> index = BuildIndex(objects);
+    std::vector<Object const*> list;
+    for (Object const& object : objects)
+        list.push_back(&object);
+
+    uint64 listFound = 0;
+    for (std::size_t i = 0; i < Searches; ++i)
+    {
+        float x = float(i % 66), y = float(i * 7 % 66);
+        for (Object const* object : list)
+            if (InRange(*object, x, y, Radius))
+                ++listFound;
+    }
+
+    uint64 indexFound = 0;
+    for (std::size_t i = 0; i < Searches; ++i)
+    {
+        float x = float(i % 66), y = float(i * 7 % 66);
+        index.VisitInRange(x, y, Radius, [&](Object const* object)
+        {
+            if (InRange(*object, x, y, Radius))
+                ++indexFound;
+            return true;
+        });
+    }
+
+    REQUIRE(listFound != 0);
+    REQUIRE(listFound == indexFound);
+}
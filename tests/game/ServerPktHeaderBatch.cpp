@@ -0,0 +1,215 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "OpenSSLCrypto.h"
+#include "ServerPktHeader.h"
+#include <vector>
+
+namespace
+{
+    struct SyntheticPacket
+    {
+        uint32 Size;
+        uint16 Opcode;
+        bool Encrypt;
+    };
+
+    // one second of a busy session, mostly small packets with a few large update packets
+    std::vector<SyntheticPacket> MakeSession(std::size_t packetCount, std::size_t unencrypted)
+    {
+        std::vector<SyntheticPacket> packets;
+        packets.reserve(packetCount);
+        for (std::size_t i = 0; i < packetCount; ++i)
+            packets.push_back({ uint32(i % 97 ? 20 + i % 200 : 0x8000 + i), uint16(i & 0x3FF), i >= unencrypted });
+        return packets;
+    }
+
+    // stream cipher stand in, keeps the test independent of OpenSSL providers
+    struct XorStreamCrypt
+    {
+        void EncryptSend(uint8* data, size_t len)
+        {
+            for (size_t i = 0; i < len; ++i)
+                data[i] ^= uint8(++State * 131);
+        }
+
+        uint32 State = 0;
+    };
+
+    // RC4 lives in the legacy provider on OpenSSL 3
+    struct OpenSSLSetup
+    {
+        OpenSSLSetup() { OpenSSLCrypto::threadsSetup(boost::filesystem::path()); }
+        ~OpenSSLSetup() { OpenSSLCrypto::threadsCleanup(); }
+    };
+
+    SessionKey MakeSessionKey()
+    {
+        SessionKey key;
+        for (std::size_t i = 0; i < key.size(); ++i)
+            key[i] = uint8(i * 7 + 1);
+        return key;
+    }
+
+    // sends packets in two batches, the second one checks that the cipher state still matches per packet encryption
+    template<class Crypt>
+    void CheckMixedBatch(Crypt& perPacketCrypt, Crypt& batchCrypt, std::vector<SyntheticPacket> const& packets)
+    {
+        for (std::vector<SyntheticPacket> const& sent : { packets, MakeSession(20, 0) })
+        {
+            std::vector<uint8> expected;
+            for (SyntheticPacket const& packet : sent)
+            {
+                ServerPktHeader header(packet.Size, packet.Opcode);
+                if (packet.Encrypt)
+                    perPacketCrypt.EncryptSend(header.header, header.getHeaderLength());
+                expected.insert(expected.end(), header.header, header.header + header.getHeaderLength());
+            }
+
+            ServerPktHeaderBatch batch;
+            for (SyntheticPacket const& packet : sent)
+                batch.Add(packet.Size, packet.Opcode, packet.Encrypt);
+            batch.Encrypt(batchCrypt);
+
+            std::vector<uint8> actual;
+            for (std::size_t i = 0; i < batch.GetCount(); ++i)
+                actual.insert(actual.end(), batch.GetHeader(i), batch.GetHeader(i) + batch.GetHeaderLength(i));
+
+            REQUIRE(actual == expected);
+        }
+    }
+}
+
+TEST_CASE("ServerPktHeaderBatch: Same output as per packet encryption", "[ServerPktHeaderBatch]")
+{
+    std::vector<SyntheticPacket> packets = MakeSession(1000, 3);
+
+    XorStreamCrypt perPacketCrypt;
+    std::vector<uint8> expected;
+    for (SyntheticPacket const& packet : packets)
+    {
+        ServerPktHeader header(packet.Size, packet.Opcode);
+        if (packet.Encrypt)
+            perPacketCrypt.EncryptSend(header.header, header.getHeaderLength());
+        expected.insert(expected.end(), header.header, header.header + header.getHeaderLength());
+    }
+
+    XorStreamCrypt batchCrypt;
+    ServerPktHeaderBatch batch;
+    for (SyntheticPacket const& packet : packets)
+        batch.Add(packet.Size, packet.Opcode, packet.Encrypt);
+    batch.Encrypt(batchCrypt);
+
+    REQUIRE(batch.GetCount() == packets.size());
+    std::vector<uint8> actual;
+    for (std::size_t i = 0; i < batch.GetCount(); ++i)
+        actual.insert(actual.end(), batch.GetHeader(i), batch.GetHeader(i) + batch.GetHeaderLength(i));
+
+    REQUIRE(actual == expected);
+}
+
+TEST_CASE("ServerPktHeaderBatch: Same output with AuthCrypt", "[ServerPktHeaderBatch]")
+{
+    OpenSSLSetup openssl;
+    std::vector<SyntheticPacket> packets = MakeSession(1000, 0);
+
+    AuthCrypt perPacketCrypt;
+    perPacketCrypt.Init(MakeSessionKey());
+    std::vector<uint8> expected;
+    for (SyntheticPacket const& packet : packets)
+    {
+        ServerPktHeader header(packet.Size, packet.Opcode);
+        perPacketCrypt.EncryptSend(header.header, header.getHeaderLength());
+        expected.insert(expected.end(), header.header, header.header + header.getHeaderLength());
+    }
+
+    AuthCrypt batchCrypt;
+    batchCrypt.Init(MakeSessionKey());
+    ServerPktHeaderBatch batch;
+    for (SyntheticPacket const& packet : packets)
+        batch.Add(packet.Size, packet.Opcode, packet.Encrypt);
+    batch.Encrypt(batchCrypt);
+
+    std::vector<uint8> actual;
+    for (std::size_t i = 0; i < batch.GetCount(); ++i)
+        actual.insert(actual.end(), batch.GetHeader(i), batch.GetHeader(i) + batch.GetHeaderLength(i));
+
+    REQUIRE(actual == expected);
+}
+
+TEST_CASE("ServerPktHeaderBatch: Unencrypted headers between encrypted ones", "[ServerPktHeaderBatch]")
+{
+    // single unencrypted headers and a run of two, the batch also starts and ends with encrypted ones
+    std::vector<SyntheticPacket> packets = MakeSession(200, 0);
+    for (std::size_t i = 0; i < packets.size(); ++i)
+        if (i % 50 == 7 || i == 120 || i == 121)
+            packets[i].Encrypt = false;
+
+    SECTION("Stream cipher")
+    {
+        XorStreamCrypt perPacketCrypt, batchCrypt;
+        CheckMixedBatch(perPacketCrypt, batchCrypt, packets);
+        REQUIRE(perPacketCrypt.State == batchCrypt.State);
+    }
+
+    SECTION("AuthCrypt")
+    {
+        OpenSSLSetup openssl;
+        AuthCrypt perPacketCrypt, batchCrypt;
+        perPacketCrypt.Init(MakeSessionKey());
+        batchCrypt.Init(MakeSessionKey());
+        CheckMixedBatch(perPacketCrypt, batchCrypt, packets);
+    }
+}
+
+TEST_CASE("ServerPktHeaderBatch: Throughput", "[.][benchmark]")
+{
+    OpenSSLSetup openssl;
+    // one second of a 10k packets/s session
+    std::vector<SyntheticPacket> packets = MakeSession(10000, 0);
+
+    AuthCrypt perPacketCrypt;
+    perPacketCrypt.Init(MakeSessionKey());
+    BENCHMARK("per packet")
+    {
+        uint32 checksum = 0;
+        for (SyntheticPacket const& packet : packets)
+        {
+            ServerPktHeader header(packet.Size, packet.Opcode);
+            perPacketCrypt.EncryptSend(header.header, header.getHeaderLength());
+            checksum += header.header[0];
+        }
+        return checksum;
+    };
+
+    AuthCrypt batchCrypt;
+    batchCrypt.Init(MakeSessionKey());
+    ServerPktHeaderBatch batch;
+    BENCHMARK("batched")
+    {
+        uint32 checksum = 0;
+        batch.Clear();
+        for (SyntheticPacket const& packet : packets)
+            batch.Add(packet.Size, packet.Opcode, true);
+        batch.Encrypt(batchCrypt);
+        for (std::size_t i = 0; i < batch.GetCount(); ++i)
+            checksum += batch.GetHeader(i)[0];
+        return checksum;
+    };
+}
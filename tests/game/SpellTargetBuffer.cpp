@@ -0,0 +1,117 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "Define.h"
+#include "SpellTargetBuffer.h"
+#include <list>
+#include <vector>
+
+namespace
+{
+    struct Candidate
+    {
+        float X;
+        float Y;
+        bool Alive;
+    };
+
+    // a raid fight: 120 units around the caster, 40 of them alive and inside the AoE radius
+    std::vector<Candidate> MakeRaid()
+    {
+        std::vector<Candidate> raid;
+        for (uint32 i = 0; i < 120; ++i)
+        {
+            float distance = i % 3 == 0 ? float(i % 25) : 30.0f + float(i % 20);
+            raid.push_back({ distance, float(i % 7) * 0.1f, i % 60 != 1 });
+        }
+        return raid;
+    }
+
+    // grid search into the target container, then one AddUnitTarget per target
+    template<class Container>
+    uint64 SelectAreaTargets(std::vector<Candidate>& raid, Container& targets)
+    {
+        constexpr float Radius = 25.0f;
+        for (Candidate& candidate : raid)
+            if (candidate.Alive && candidate.X * candidate.X + candidate.Y * candidate.Y <= Radius * Radius)
+                targets.push_back(&candidate);
+
+        uint64 checksum = 0;
+        for (Candidate* target : targets)
+            checksum += uint64(target->X);
+        return checksum;
+    }
+}
+
+TEST_CASE("SpellTargetBuffer: Buffers are reused", "[SpellTargetBuffer]")
+{
+    int const* data;
+    {
+        PooledTargetBuffer<int> buffer;
+        (*buffer).resize(40);
+        data = (*buffer).data();
+    }
+
+    std::size_t const pooled = PooledTargetBuffer<int>::GetPooledCount();
+    PooledTargetBuffer<int> buffer;
+    REQUIRE((*buffer).empty());
+    REQUIRE((*buffer).data() == data);
+    REQUIRE(PooledTargetBuffer<int>::GetPooledCount() == pooled - 1);
+
+    // nested selections get their own storage
+    (*buffer).push_back(1);
+    {
+        PooledTargetBuffer<int> nested;
+        REQUIRE((*nested).empty());
+        (*nested).push_back(2);
+    }
+    REQUIRE((*buffer).size() == 1);
+}
+
+TEST_CASE("SpellTargetBuffer: Large buffers are not kept", "[SpellTargetBuffer]")
+{
+    std::size_t const pooled = PooledTargetBuffer<int>::GetPooledCount();
+    {
+        PooledTargetBuffer<int> buffer;
+        (*buffer).resize(PooledTargetBuffer<int>::MAX_POOLED_BUFFER_CAPACITY + 1);
+    }
+    REQUIRE(PooledTargetBuffer<int>::GetPooledCount() <= pooled);
+}
+
+TEST_CASE("SpellTargetBuffer: 40 target AoE selection", "[.][benchmark]")
+{
+    std::vector<Candidate> raid = MakeRaid();
+    {
+        std::list<Candidate*> targets;
+        SelectAreaTargets(raid, targets);
+        REQUIRE(targets.size() == 40);
+    }
+
+    BENCHMARK("std::list")
+    {
+        std::list<Candidate*> targets;
+        return SelectAreaTargets(raid, targets);
+    };
+
+    BENCHMARK("pooled vector")
+    {
+        PooledTargetBuffer<Candidate*> buffer;
+        return SelectAreaTargets(raid, *buffer);
+    };
+}
@@ -39,6 +39,7 @@ inline std::ostream& operator<<(std::ostream& os, std::nullopt_t)
     return os;
 }
 
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include "catch2/catch.hpp"
 
 #endif